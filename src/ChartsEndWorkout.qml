@@ -34,19 +34,35 @@ ChartsEndWorkoutForm {
         timer.stopTimer(sendMail)
     }
 
+    // the model downsamples the session to the chart width
+    function fillCharts()
+    {
+        rootItem.workout_chart.fillSeries(powerSeries, "watt", powerChart.width);
+        rootItem.workout_chart.fillSeries(heartSeries, "heart", heartChart.width);
+        rootItem.workout_chart.fillSeries(cadenceSeries, "cadence", cadenceChart.width);
+        rootItem.workout_chart.fillSeries(resistanceSeries, "resistance", cadenceChart.width);
+        rootItem.workout_chart.fillSeries(pelotonResistanceSeries, "peloton_resistance", cadenceChart.width);
+    }
+
+    // during a workout the charts follow the samples of the session
+    Connections {
+        target: rootItem.workout_chart
+        function onCountChanged(count) {
+            fillCharts();
+        }
+    }
+
+    Connections {
+        target: powerChart
+        function onWidthChanged() {
+            fillCharts();
+        }
+    }
+
     Component.onCompleted: {
         headerToolbar.visible = true;
 
-        //console.log("ChartsEndWorkoutForm completed " + rootItem.workout_sample_points)
-        for(var i=0;i<rootItem.workout_sample_points;i+=10)
-        {
-            //console.log("ChartsEndWorkoutForm completed " + i + " " + rootItem.workout_watt_points[i])
-            powerSeries.append(i * 1000, rootItem.workout_watt_points[i]);
-            heartSeries.append(i * 1000, rootItem.workout_heart_points[i]);
-            cadenceSeries.append(i * 1000, rootItem.workout_cadence_points[i]);
-            resistanceSeries.append(i * 1000, rootItem.workout_resistance_points[i]);
-            pelotonResistanceSeries.append(i * 1000, rootItem.workout_peloton_resistance_points[i]);
-        }
+        fillCharts();
         rootItem.update_chart_power(powerChart);
         //rootItem.update_axes(valueAxisX, valueAxisY);
         rootItem.update_chart_heart(heartChart);
@@ -144,7 +144,7 @@ Item {
                     id: valueAxisX
                     tickCount: 7
                     min: new Date(0)
-                    max: new Date(rootItem.workout_sample_points * 1000)
+                    max: new Date(rootItem.workout_chart.durationMs)
                     format: "mm:ss"
                     //labelsVisible: false
                     gridVisible: false
@@ -190,7 +190,7 @@ Item {
                     id: valueAxisXHR
                     tickCount: 7
                     min: new Date(0)
-                    max: new Date(rootItem.workout_sample_points * 1000)
+                    max: new Date(rootItem.workout_chart.durationMs)
                     format: "mm:ss"
                     //labelsVisible: false
                     gridVisible: false
@@ -235,7 +235,7 @@ Item {
                 DateTimeAxis {
                     id: valueAxisXCadence
                     min: new Date(0)
-                    max: new Date(rootItem.workout_sample_points * 1000)
+                    max: new Date(rootItem.workout_chart.durationMs)
                     format: "mm:ss"
                     tickCount: 7
                     //labelsVisible: false
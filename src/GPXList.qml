@@ -212,40 +212,70 @@ ColumnLayout {
                     center: pathController.center
                     visible: true
 
+                    // remaining and ridden routes are separate layers, both updated incrementally
                     MapPolyline {
                         id: pl
                         line.width: 3
                         line.color: 'red'
                     }
+                    MapPolyline {
+                        id: ridden
+                        line.width: 3
+                        line.color: 'blue'
+                    }
+                    onZoomLevelChanged: pathController.zoomlevel = zoomLevel
                     Component.onCompleted: {
                         console.log("Dimensions: ", width, height)
+                        pathController.zoomlevel = zoomLevel
                     }
                 }
 
                 function loadPath(){
-                    var lines = []
+                    var geopath = pathController.geopath
                     var elevationGain = 0
-                    var offsetElevation = 0
-                    for(var i = 0; i < pathController.geopath.size(); i++){
-                        if(i > 0 && pathController.geopath.coordinateAt(i).altitude > pathController.geopath.coordinateAt(i-1).altitude)
-                            elevationGain = elevationGain + (pathController.geopath.coordinateAt(i).altitude - pathController.geopath.coordinateAt(i-1).altitude)
-                        lines[i] = pathController.geopath.coordinateAt(i)
+                    for(var i = 1; i < geopath.size(); i++){
+                        if(geopath.coordinateAt(i).altitude > geopath.coordinateAt(i-1).altitude)
+                            elevationGain = elevationGain + (geopath.coordinateAt(i).altitude - geopath.coordinateAt(i-1).altitude)
                     }
-                    distance.text = "Distance " + (pathController.geopath.length() / 1000.0).toFixed(1) + " km Elevation Gain: " + elevationGain.toFixed(1) + " meters"
-                    return lines;
+                    distance.text = "Distance " + (geopath.length() / 1000.0).toFixed(1) + " km Elevation Gain: " + elevationGain.toFixed(1) + " meters"
+                }
+
+                function loadRemainingPath(){
+                    pl.path = pathController.simplifiedpath.path.slice(Math.max(0, pathController.remainingstart))
                 }
 
                 Connections{
                     target: pathController
                     onGeopathChanged: {
-                        pl.path = row.loadPath();
+                        row.loadPath();
+                    }
+                    onSimplifiedpathChanged: {
+                        row.loadRemainingPath();
+                    }
+                    onRemainingStartChanged: {
+                        if(previous < 0 || current < previous) {
+                            row.loadRemainingPath();
+                        } else {
+                            for(var i = previous; i < current; i++)
+                                pl.removeCoordinate(0);
+                        }
+                    }
+                    onRiddenPointAppended: {
+                        ridden.addCoordinate(coordinate);
+                    }
+                    onRiddenpathChanged: {
+                        ridden.path = pathController.riddenpath.path;
                     }
                     onCenterChanged: {
                         map.center = pathController.center;
                     }
                 }
 
-                Component.onCompleted: pl.path = loadPath()
+                Component.onCompleted: {
+                    loadPath();
+                    loadRemainingPath();
+                    ridden.path = pathController.riddenpath.path;
+                }
             }
         }
     }
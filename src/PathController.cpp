@@ -4,6 +4,8 @@
 #include "PathController.h"
 
 #include <QtDebug>
+#include <algorithm>
+#include <cmath>
 
 W_OBJECT_IMPL(PathController)
 
@@ -35,5 +37,165 @@ PathController::PathController(QObject *parent)
     }
 }
 
+namespace {
+// tolerances in meters of the levels of detail, the first one is the full route
+const double lodTolerances[] = {0, 2, 8, 32, 128, 512};
+// a ridden point farther than this from the route doesn't move the remaining route
+const double routeMatchMeters = 50;
+// how many route points ahead are checked for every ridden point
+const int routeSearchWindow = 100;
 
+double distanceFromSegment(const QGeoCoordinate &p, const QGeoCoordinate &a, const QGeoCoordinate &b) {
+    // local equirectangular projection, plenty for the distances between two gpx points
+    const double metersPerDegree = 111320.0;
+    const double cosLat = std::cos(a.latitude() * M_PI / 180.0);
+    const double bx = (b.longitude() - a.longitude()) * metersPerDegree * cosLat;
+    const double by = (b.latitude() - a.latitude()) * metersPerDegree;
+    const double px = (p.longitude() - a.longitude()) * metersPerDegree * cosLat;
+    const double py = (p.latitude() - a.latitude()) * metersPerDegree;
+    const double len2 = bx * bx + by * by;
+    double t = len2 > 0 ? (px * bx + py * by) / len2 : 0;
+    t = qBound(0.0, t, 1.0);
+    return std::hypot(px - t * bx, py - t * by);
+}
+} // namespace
+
+void PathController::buildLevelsOfDetail() {
+    mLevels.clear();
+    const int n = mGeoPath.size();
+    const QList<QGeoCoordinate> path = mGeoPath.path();
+
+    for (double tolerance : lodTolerances) {
+        QVector<int> kept;
+        if (tolerance == 0 || n < 3) {
+            kept.reserve(n);
+            for (int i = 0; i < n; i++)
+                kept.append(i);
+            mLevels.append(kept);
+            continue;
+        }
+
+        // Douglas-Peucker, with an explicit stack because the routes can have thousands of points
+        QVector<bool> keep(n, false);
+        keep[0] = keep[n - 1] = true;
+        QVector<QPair<int, int>> stack;
+        stack.append(qMakePair(0, n - 1));
+        while (!stack.isEmpty()) {
+            QPair<int, int> segment = stack.takeLast();
+            double maxDistance = 0;
+            int index = -1;
+            for (int i = segment.first + 1; i < segment.second; i++) {
+                double d = distanceFromSegment(path.at(i), path.at(segment.first), path.at(segment.second));
+                if (d > maxDistance) {
+                    maxDistance = d;
+                    index = i;
+                }
+            }
+            if (index != -1 && maxDistance > tolerance) {
+                keep[index] = true;
+                stack.append(qMakePair(segment.first, index));
+                stack.append(qMakePair(index, segment.second));
+            }
+        }
+        for (int i = 0; i < n; i++) {
+            if (keep.at(i))
+                kept.append(i);
+        }
+        mLevels.append(kept);
+    }
+
+    mLevel = -1;
+    updateSimplifiedPath();
+}
+
+void PathController::setZoomLevel(double zoomLevel) {
+    if (zoomLevel == mZoomLevel) {
+        return;
+    }
+    mZoomLevel = zoomLevel;
+    emit zoomlevelChanged();
+    updateSimplifiedPath();
+}
+
+void PathController::updateSimplifiedPath() {
+    if (mLevels.isEmpty()) {
+        return;
+    }
+
+    // the coarsest level whose tolerance is still below one pixel at the current zoom
+    const double latitude = mGeoPath.isEmpty() ? 0 : mGeoPath.coordinateAt(0).latitude();
+    const double metersPerPixel = 156543.03392 * std::cos(latitude * M_PI / 180.0) / std::pow(2.0, mZoomLevel);
+    int level = 0;
+    for (int i = 1; i < mLevels.count(); i++) {
+        if (lodTolerances[i] <= metersPerPixel)
+            level = i;
+    }
+    if (level == mLevel) {
+        return;
+    }
 
+    mLevel = level;
+    QList<QGeoCoordinate> simplified;
+    simplified.reserve(mLevels.at(level).count());
+    for (int i : mLevels.at(level)) {
+        simplified.append(mGeoPath.coordinateAt(i));
+    }
+    mSimplifiedPath.setPath(simplified);
+    emit simplifiedpathChanged();
+
+    // the index of the remaining route depends on the level
+    mRemainingStart = -1;
+    updateRemainingStart();
+}
+
+void PathController::appendRiddenPoint(const QGeoCoordinate &coordinate) {
+    if (!coordinate.isValid()) {
+        return;
+    }
+    if (mRiddenPath.size() && mRiddenPath.coordinateAt(mRiddenPath.size() - 1) == coordinate) {
+        return;
+    }
+
+    mRiddenPath.addCoordinate(coordinate);
+    emit riddenPointAppended(coordinate);
+
+    // move forward on the route only, looking at the nearest point in a small window
+    const int n = mGeoPath.size();
+    double best = routeMatchMeters;
+    int bestIndex = -1;
+    for (int i = mRouteIndex; i < n && i < mRouteIndex + routeSearchWindow; i++) {
+        double d = mGeoPath.coordinateAt(i).distanceTo(coordinate);
+        if (d < best) {
+            best = d;
+            bestIndex = i;
+        }
+    }
+    if (bestIndex > mRouteIndex) {
+        mRouteIndex = bestIndex;
+        updateRemainingStart();
+    }
+}
+
+void PathController::clearRidden() {
+    mRiddenPath.setPath(QList<QGeoCoordinate>());
+    mRouteIndex = 0;
+    mRemainingStart = -1;
+    updateRemainingStart();
+    emit riddenpathChanged();
+}
+
+void PathController::updateRemainingStart() {
+    int start = 0;
+    if (mLevel >= 0 && mLevel < mLevels.count()) {
+        const QVector<int> &kept = mLevels.at(mLevel);
+        // the remaining route starts from the last simplified point already reached
+        start = std::upper_bound(kept.constBegin(), kept.constEnd(), mRouteIndex) - kept.constBegin() - 1;
+        start = qMax(0, start);
+    }
+    if (start == mRemainingStart) {
+        return;
+    }
+    int previous = mRemainingStart;
+    mRemainingStart = start;
+    emit remainingStartChanged(previous, start);
+}
@@ -8,7 +8,17 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QVector>
 
+/**
+ * @brief Route shown on the map. Besides the whole route it keeps:
+ * - a level of detail simplified version of the route, chosen from the map zoom level;
+ * - the ridden path, where the points are only appended (riddenPointAppended);
+ * - the index in the simplified route where the remaining route starts (remainingStartChanged),
+ * so the map layers can be updated incrementally instead of replacing the whole path every second.
+ * These layers are drawn by the QtLocation map of the GPX list (GPXList.qml), with the ridden track of the session
+ * over the route in preview; the map shown while riding is the maps2d web template, fed by the template web server.
+ */
 class PathController : public QObject {
     // Q_OBJECT
     W_OBJECT(PathController)
@@ -23,6 +33,9 @@ class PathController : public QObject {
             return;
         }
         mGeoPath = geoPath;
+        // the ridden path belongs to the session, not to the route: only the match on the route starts again
+        mRouteIndex = 0;
+        buildLevelsOfDetail();
         emit geopathChanged();
     }
 
@@ -42,11 +55,47 @@ class PathController : public QObject {
 
     void centerChanged() W_SIGNAL(centerChanged)
 
-        private : QGeoPath mGeoPath;
+  public:
+    QGeoPath simplifiedPath() const { return mSimplifiedPath; }
+    double zoomLevel() const { return mZoomLevel; }
+    void setZoomLevel(double zoomLevel);
+
+    QGeoPath riddenPath() const { return mRiddenPath; }
+    int remainingStart() const { return mRemainingStart; }
+    void appendRiddenPoint(const QGeoCoordinate &coordinate);
+    void clearRidden();
+
+    void simplifiedpathChanged() W_SIGNAL(simplifiedpathChanged)
+    void zoomlevelChanged() W_SIGNAL(zoomlevelChanged)
+    void riddenpathChanged() W_SIGNAL(riddenpathChanged)
+    void riddenPointAppended(QGeoCoordinate coordinate) W_SIGNAL(riddenPointAppended, (QGeoCoordinate), coordinate)
+    void remainingStartChanged(int previous, int current)
+        W_SIGNAL(remainingStartChanged, (int, int), previous, current)
+
+  private:
+    void buildLevelsOfDetail();
+    void updateSimplifiedPath();
+    void updateRemainingStart();
+
+    QGeoPath mGeoPath;
     QGeoCoordinate mCenter;
 
+    // indices of mGeoPath kept by each level of detail, level 0 is the full route
+    QVector<QVector<int>> mLevels;
+    int mLevel = -1;
+    double mZoomLevel = 14;
+    QGeoPath mSimplifiedPath;
+
+    QGeoPath mRiddenPath;
+    int mRouteIndex = 0;
+    int mRemainingStart = 0;
+
     W_PROPERTY(QGeoPath, geopath READ geoPath WRITE setGeoPath NOTIFY geopathChanged)
     W_PROPERTY(QGeoCoordinate, center READ center WRITE setCenter NOTIFY centerChanged)
+    W_PROPERTY(QGeoPath, simplifiedpath READ simplifiedPath NOTIFY simplifiedpathChanged)
+    W_PROPERTY(double, zoomlevel READ zoomLevel WRITE setZoomLevel NOTIFY zoomlevelChanged)
+    W_PROPERTY(QGeoPath, riddenpath READ riddenPath NOTIFY riddenpathChanged)
+    W_PROPERTY(int, remainingstart READ remainingStart NOTIFY remainingStartChanged)
 };
 
 #endif // APPLICATION_PATHCONTROLLER_H
@@ -73,4 +73,35 @@ ColumnLayout {
             onClicked: portRow.doSavePort(textTcpClientPort.text)
         }
     }
+    RowLayout {
+        spacing: 10
+        id: flushRow
+        Label {
+            id: labelTcpClientFlush
+            text: qsTr(rootElement.templateId + " Flush interval (ms):")
+            Layout.fillWidth: true
+        }
+        function doSaveFlush(text) {
+            let flush = parseInt(text);
+            console.log("Saving flush interval for "+rootElement.templateId + " "+ text + " converted "+flush);
+            if (!isNaN(flush) && flush >= 0 && flush <= 5000)
+                settings.setValue("template_"+rootElement.templateId+"_flush_ms", flush);
+        }
+
+        TextField {
+            id: textTcpClientFlush
+            text: settings.value("template_"+rootElement.templateId+"_flush_ms",50) + "";
+            horizontalAlignment: Text.AlignRight
+            Layout.fillHeight: false
+            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+            inputMethodHints: Qt.ImhDigitsOnly
+            onAccepted: flushRow.doSaveFlush(text)
+        }
+        Button {
+            id: buttonTcpClientFlush
+            text: "OK"
+            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+            onClicked: flushRow.doSaveFlush(textTcpClientFlush.text)
+        }
+    }
 }
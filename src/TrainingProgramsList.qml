@@ -218,7 +218,7 @@ ColumnLayout {
                     anchors.top: date.bottom
                     id: description
                     width: parent.width
-                    text: rootItem.previewWorkoutTags
+                    text: rootItem.previewWorkoutSummary + (rootItem.previewWorkoutTags ? "\n" + rootItem.previewWorkoutTags : "")
                     font.pixelSize: 10
                     wrapMode: Text.WordWrap
                     color: "white"
@@ -3,22 +3,29 @@
 #include "qdebugfixup.h"
 #include <QSettings>
 
-bike::bike() { elapsed.setType(metric::METRIC_ELAPSED); }
+bike::bike() {
+    elapsed.setType(metric::METRIC_ELAPSED);
+    ergController.setFeedForward([this](double power) { return (double)resistanceFromPowerRequest(power); });
+    connect(&ergTimer, &QTimer::timeout, this, &bike::ergUpdate);
+    connect(&gearTimer, &QTimer::timeout, this, &bike::gearUpdate);
+    virtualGearing.load();
+}
 
 void bike::changeResistance(resistance_t resistance) {
     lastRawRequestedResistanceValue = resistance;
     if (autoResistanceEnable) {
-        double v = (resistance * m_difficult) + gears();
+        double v = (resistance * m_difficult) + gearsOffset();
         requestResistance = v;
         emit resistanceChanged(requestResistance);
     }
-    RequestedResistance = resistance * m_difficult + gears();
+    RequestedResistance = resistance * m_difficult + gearsOffset();
 }
 
 void bike::changeInclination(double grade, double percentage) {
     qDebug() << QStringLiteral("bike::changeInclination") << autoResistanceEnable << grade << percentage;
     if (autoResistanceEnable) {
         requestInclination = grade;
+        learnInclinationCommand(grade);
     }
     emit inclinationChanged(grade, percentage);
 }
@@ -46,6 +53,32 @@ void bike::changePower(int32_t power) {
     double zwift_erg_resistance_up = settings.value(QZSettings::zwift_erg_resistance_up, QZSettings::default_zwift_erg_resistance_up).toDouble();
     double zwift_erg_resistance_down = settings.value(QZSettings::zwift_erg_resistance_down, QZSettings::default_zwift_erg_resistance_down).toDouble();
 
+    bool erg_closed_loop =
+        settings.value(QZSettings::zwift_erg_closed_loop, QZSettings::default_zwift_erg_closed_loop).toBool();
+
+    if (!ergModeSupported && force_resistance && erg_closed_loop && power > 0) {
+        ergController.setLimits(zwift_erg_resistance_down, qMin(zwift_erg_resistance_up, (double)maxResistance()));
+        ergController.setSettlingTime(settings.value(QZSettings::zwift_erg_settling_time,
+                                                     QZSettings::default_zwift_erg_settling_time).toDouble());
+        ergController.setMaxRate(
+            settings.value(QZSettings::zwift_erg_max_rate, QZSettings::default_zwift_erg_max_rate).toDouble());
+        if (ergController.target() > 0 && ergController.target() != power) {
+            qDebug() << QStringLiteral("ERG step to") << ergController.target() << QStringLiteral("overshoot")
+                     << ergController.stepOvershoot() << QStringLiteral("settling time")
+                     << ergController.stepSettlingTime();
+        }
+        ergController.setTarget(power);
+        if (!ergTimer.isActive()) {
+            ergClock.invalidate();
+            ergTimer.start(1000);
+        }
+        ergUpdate();
+        return;
+    } else if (ergTimer.isActive()) {
+        ergTimer.stop();
+        ergController.reset();
+    }
+
     double deltaDown = wattsMetric().value() - ((double)power);
     double deltaUp = ((double)power) - wattsMetric().value();
     qDebug() << QStringLiteral("filter  ") + QString::number(deltaUp) + " " + QString::number(deltaDown) + " " +
@@ -53,6 +86,7 @@ void bike::changePower(int32_t power) {
     if (!ergModeSupported && force_resistance /*&& erg_mode*/ &&
         (deltaUp > erg_filter_upper || deltaDown > erg_filter_lower)) {
         resistance_t r = (resistance_t)resistanceFromPowerRequest(power);
+        qDebug() << QStringLiteral("resistanceFromPowerRequest") << power << currentCadence().value() << r;
         if ((double)r > zwift_erg_resistance_up) {
             qDebug() << "zwift_erg_resistance_up filter enabled!";
             r = (resistance_t)zwift_erg_resistance_up;
@@ -64,15 +98,78 @@ void bike::changePower(int32_t power) {
     }
 }
 
+void bike::ergUpdate() {
+    double dt = ergClock.isValid() ? ergClock.restart() / 1000.0 : 0;
+    if (!ergClock.isValid())
+        ergClock.start();
+    if (paused)
+        return;
+    resistance_t r =
+        (resistance_t)qRound(ergController.update(wattsMetric().value(), currentCadence().value(), dt));
+    if (r != lastRawRequestedResistanceValue) {
+        qDebug() << QStringLiteral("ERG closed loop") << ergController.target() << wattsMetric().value()
+                 << ergController.correction() << r;
+        changeResistance(r);
+    }
+}
+
 int8_t bike::gears() { return m_gears; }
 void bike::setGears(int8_t gears) {
     qDebug() << "setGears" << gears;
+    if (virtualGearing.isEnabled()) {
+        m_gears = virtualGearing.setGear(gears);
+        qDebug() << QStringLiteral("virtual gear") << virtualGearing.gearName();
+        applyVirtualGearing();
+        return;
+    }
     m_gears = gears;
     if (lastRawRequestedResistanceValue != -1) {
         changeResistance(lastRawRequestedResistanceValue);
     }
 }
 
+bool bike::setSimulationParameters(double grade, double windSpeed, double crr) {
+    if (!virtualGearing.isEnabled())
+        return false;
+    virtualGearing.setSimulation(grade, windSpeed, crr);
+    if (!gearTimer.isActive())
+        gearTimer.start(1000);
+    return applyVirtualGearing();
+}
+
+void bike::clearSimulationParameters() {
+    virtualGearing.clearSimulation();
+    gearTimer.stop();
+}
+
+void bike::gearUpdate() {
+    if (paused)
+        return;
+    // during steady riding the game sends no new parameters: the power of the gear still changes with the cadence
+    if (qRound(Cadence.value()) != qRound(gearCadence) || qAbs(Speed.value() - gearSpeed) >= 0.5)
+        applyVirtualGearing();
+}
+
+bool bike::applyVirtualGearing() {
+    if (!virtualGearing.hasSimulation())
+        return false;
+    double cadence = Cadence.value();
+    gearCadence = cadence;
+    gearSpeed = Speed.value();
+    if (inclinationAvailableByHardware() || !hasResistancePowerModel()) {
+        // the bike simulates the road at its own speed (or it has no model from power to resistance): the grade where
+        // that speed needs the power of the gear
+        double grade = virtualGearing.grade(cadence, Speed.value());
+        changeInclination(grade, grade);
+        return true;
+    } else if (cadence > 0) {
+        double power = virtualGearing.power(cadence);
+        changeResistance(resistanceFromPowerRequest(power));
+        return true;
+    }
+    return false;
+}
+
 double bike::currentCrankRevolutions() { return CrankRevs; }
 uint16_t bike::lastCrankEventTime() { return LastCrankEventTime; }
 metric bike::lastRequestedResistance() { return RequestedResistance; }
@@ -87,7 +184,10 @@ metric bike::pelotonResistance() { return m_pelotonResistance; }
 resistance_t bike::pelotonToBikeResistance(int pelotonResistance) { return pelotonResistance; }
 resistance_t bike::resistanceFromPowerRequest(uint16_t power) { return power / 10; } // in order to have something
 void bike::cadenceSensor(uint8_t cadence) { Cadence.setValue(cadence); }
-void bike::powerSensor(uint16_t power) { m_watt.setValue(power, false); }
+void bike::powerSensor(uint16_t power) {
+    m_watt.setValue(power, false);
+    learnPowerCurve(power);
+}
 
 bluetoothdevice::BLUETOOTH_TYPE bike::deviceType() { return bluetoothdevice::BIKE; }
 
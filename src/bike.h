@@ -2,7 +2,11 @@
 #define BIKE_H
 
 #include "bluetoothdevice.h"
+#include "ergcontroller.h"
+#include "virtualgearing.h"
+#include <QElapsedTimer>
 #include <QObject>
+#include <QTimer>
 
 class bike : public bluetoothdevice {
 
@@ -22,6 +26,8 @@ class bike : public bluetoothdevice {
     virtual uint16_t watts();
     virtual resistance_t pelotonToBikeResistance(int pelotonResistance);
     virtual resistance_t resistanceFromPowerRequest(uint16_t power);
+    // true when resistanceFromPowerRequest is a model of the bike, not the generic power / 10
+    virtual bool hasResistancePowerModel() { return false; }
     virtual uint16_t powerFromResistanceRequest(resistance_t requestResistance);
     virtual bool ergManagedBySS2K() { return false; }
     bluetoothdevice::BLUETOOTH_TYPE deviceType();
@@ -32,6 +38,22 @@ class bike : public bluetoothdevice {
     uint8_t metrics_override_heartrate();
     void setGears(int8_t d);
     int8_t gears();
+    /**
+     * @brief gearsOffset The gears to add to the requested resistance or inclination: 0 with the virtual gearing,
+     * where the gear is part of the target computed from the simulation parameters.
+     */
+    int8_t gearsOffset() { return virtualGearing.isEnabled() ? 0 : gears(); }
+    QString gearName() { return virtualGearing.isEnabled() ? virtualGearing.gearName() : QString(); }
+    /**
+     * @brief setSimulationParameters The road of the game (FTMS indoor bike simulation parameters).
+     * @return true when the virtual gearing is enabled and it has set the target of the bike
+     */
+    bool setSimulationParameters(double grade, double windSpeed, double crr);
+    /**
+     * @brief clearSimulationParameters The game left the simulation mode (ERG target): the virtual gearing stops
+     * following the cadence.
+     */
+    void clearSimulationParameters();
     void setSpeedLimit(double speed) {m_speedLimit = speed;}
     double speedLimit() {return m_speedLimit;}
 
@@ -61,6 +83,10 @@ class bike : public bluetoothdevice {
     void resistanceRead(resistance_t resistance);
     void steeringAngleChanged(double angle);
 
+  private slots:
+    void ergUpdate();
+    void gearUpdate();
+
   protected:
     metric RequestedResistance;
     metric RequestedPelotonResistance;
@@ -84,6 +110,20 @@ class bike : public bluetoothdevice {
     metric m_steeringAngle;
 
     double m_speedLimit = 0;
+
+    // chainrings and cassette for the bikes without gears, see virtual_gearing
+    virtualgearing virtualGearing;
+    // false when nothing was sent to the bike
+    bool applyVirtualGearing();
+    // the target of the gear follows the cadence and the speed of the bike, see gearUpdate
+    QTimer gearTimer;
+    double gearCadence = -1;
+    double gearSpeed = -1;
+
+    // closed loop ERG for the bikes without ergModeSupported, see zwift_erg_closed_loop
+    ergcontroller ergController;
+    QTimer ergTimer;
+    QElapsedTimer ergClock;
 };
 
 #endif // BIKE_H
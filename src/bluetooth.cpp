@@ -2012,6 +2012,19 @@ void bluetooth::connectedAndDiscovered() {
 
 void bluetooth::heartRate(uint8_t heart) { Q_UNUSED(heart) }
 
+void bluetooth::connectFakeDevice(bluetoothdevice::BLUETOOTH_TYPE type) {
+    if (device())
+        return;
+    stopDiscovery();
+    if (type == bluetoothdevice::TREADMILL)
+        fakeTreadmill = new faketreadmill(noWriteResistance, noHeartService, true);
+    else if (type == bluetoothdevice::ELLIPTICAL)
+        fakeElliptical = new fakeelliptical(noWriteResistance, noHeartService, true);
+    else
+        fakeBike = new fakebike(noWriteResistance, noHeartService, true);
+    emit deviceConnected(QBluetoothDeviceInfo());
+}
+
 void bluetooth::restart() {
 
     QSettings settings;
@@ -124,6 +124,8 @@ class bluetooth : public QObject, public SignalHandler {
     bool onlyDiscover = false;
     TemplateInfoSenderBuilder *getUserTemplateManager() const { return userTemplateManager; }
     TemplateInfoSenderBuilder *getInnerTemplateManager() const { return innerTemplateManager; }
+    // a fake device connected without a discovery, for the headless benchmarks (-test-tiles)
+    void connectFakeDevice(bluetoothdevice::BLUETOOTH_TYPE type);
 
   private:
     TemplateInfoSenderBuilder *userTemplateManager = nullptr;
@@ -126,6 +126,42 @@ void bluetoothdevice::setDifficult(double d) { m_difficult = d; }
 double bluetoothdevice::difficult() { return m_difficult; }
 void bluetoothdevice::cadenceSensor(uint8_t cadence) { Q_UNUSED(cadence) }
 void bluetoothdevice::powerSensor(uint16_t power) { Q_UNUSED(power) }
+
+powercalibration &bluetoothdevice::powerCalibration() {
+#ifdef Q_OS_IOS
+    m_powerCalibration.load(bluetoothDevice.deviceUuid().toString());
+#else
+    m_powerCalibration.load(bluetoothDevice.address().toString());
+#endif
+    return m_powerCalibration;
+}
+
+void bluetoothdevice::learnPowerCurve(uint16_t power) {
+    double model = modelWatts();
+    if (model > 0)
+        powerCalibration().addSample(Cadence.value(), Resistance.value(), model, power);
+}
+
+inclinationactuator &bluetoothdevice::inclinationActuator() {
+#ifdef Q_OS_IOS
+    m_inclinationActuator.load(bluetoothDevice.deviceUuid().toString());
+#else
+    m_inclinationActuator.load(bluetoothDevice.address().toString());
+#endif
+    return m_inclinationActuator;
+}
+
+void bluetoothdevice::learnInclinationCommand(double inclination) {
+    if (!m_inclinationClock.isValid())
+        m_inclinationClock.start();
+    inclinationActuator().command(inclination, m_inclinationClock.elapsed());
+}
+
+void bluetoothdevice::learnInclinationFeedback() {
+    if (!m_inclinationClock.isValid())
+        m_inclinationClock.start();
+    inclinationActuator().feedback(currentInclination().value(), m_inclinationClock.elapsed());
+}
 void bluetoothdevice::speedSensor(double speed) { Q_UNUSED(speed) }
 void bluetoothdevice::instantaneousStrideLengthSensor(double length) { Q_UNUSED(length); }
 void bluetoothdevice::groundContactSensor(double groundContact) { Q_UNUSED(groundContact); }
@@ -1,13 +1,17 @@
 #ifndef BLUETOOTHDEVICE_H
 #define BLUETOOTHDEVICE_H
 
+#include "commandgovernor.h"
 #include "definitions.h"
+#include "inclinationactuator.h"
 #include "metric.h"
+#include "powercalibration.h"
 #include "qzsettings.h"
 
 #include <QBluetoothDeviceDiscoveryAgent>
 #include <QBluetoothDeviceInfo>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QGeoCoordinate>
 #include <QObject>
 #include <QTimer>
@@ -384,6 +388,12 @@ class bluetoothdevice : public QObject {
   protected:
     QLowEnergyController *m_control = nullptr;
 
+    /**
+     * @brief commandGovernor The rate of the resistance and inclination commands this device can sustain. The drivers
+     * write a pending target only when it is ready.
+     */
+    commandgovernor commandGovernor;
+
     /**
      * @brief elapsed A metric object to get and set the elapsed time for the session. Units: seconds
      */
@@ -568,6 +578,46 @@ class bluetoothdevice : public QObject {
      * Units: METs (1 MET is approximately 3.5mL of Oxygen consumed per kg of body weight per minute)
      */
     double calculateMETS();
+
+    /**
+     * @brief modelWatts The power of the model of the device (wattsFromResistance) at the current cadence and
+     * resistance, without the calibration. 0 when the device has no model. Units: watts
+     */
+    virtual double modelWatts() { return 0; }
+
+    /**
+     * @brief powerCalibration The correction of the power model learned from the power sensor, for this device.
+     */
+    powercalibration &powerCalibration();
+
+    /**
+     * @brief learnPowerCurve Adds a reading of the power sensor to the calibration of the power model.
+     * @param power The power from the sensor. Unit: watts
+     */
+    void learnPowerCurve(uint16_t power);
+
+    /**
+     * @brief inclinationActuator The dead time and the slew rate of the inclination of this device, learned from the
+     * Inclination read back after every inclination command.
+     */
+    inclinationactuator &inclinationActuator();
+
+    /**
+     * @brief learnInclinationCommand Adds an inclination command to the model of the inclination actuator.
+     * @param inclination The requested inclination. Unit: %
+     */
+    void learnInclinationCommand(double inclination);
+
+    /**
+     * @brief learnInclinationFeedback Adds the current inclination to the model of the inclination actuator. To be
+     * called periodically.
+     */
+    void learnInclinationFeedback();
+
+  private:
+    powercalibration m_powerCalibration;
+    inclinationactuator m_inclinationActuator;
+    QElapsedTimer m_inclinationClock;
 };
 
 #endif // BLUETOOTHDEVICE_H
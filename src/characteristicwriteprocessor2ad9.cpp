@@ -43,7 +43,9 @@ int CharacteristicWriteProcessor2AD9::writeProcess(quint16 uuid, const QByteArra
                 reply.append((quint8)FTMS_SUCCESS);
 
                 int16_t iresistance = (((uint8_t)data.at(3)) + (data.at(4) << 8));
-                changeSlope(iresistance);
+                int16_t iwind = (((uint8_t)data.at(1)) + (data.at(2) << 8));
+                uint8_t icrr = data.size() > 5 ? (uint8_t)data.at(5) : 0;
+                changeSlope(iresistance, iwind / 1000.0, icrr / 10000.0);
             } else if (cmd == FTMS_SET_TARGET_POWER) // erg mode
 
             {
@@ -128,9 +130,14 @@ int CharacteristicWriteProcessor2AD9::writeProcess(quint16 uuid, const QByteArra
         return CP_INVALID;
 }
 
-void CharacteristicWriteProcessor2AD9::changePower(uint16_t power) { Bike->changePower(power); }
+void CharacteristicWriteProcessor2AD9::changePower(uint16_t power) {
+    // an ERG target ends the simulation the virtual gearing follows
+    if (Bike->deviceType() == bluetoothdevice::BIKE)
+        ((bike *)Bike)->clearSimulationParameters();
+    Bike->changePower(power);
+}
 
-void CharacteristicWriteProcessor2AD9::changeSlope(int16_t iresistance) {
+void CharacteristicWriteProcessor2AD9::changeSlope(int16_t iresistance, double windSpeed, double crr) {
     bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
     if (dt == bluetoothdevice::BIKE) {
       QSettings settings;
@@ -151,6 +158,11 @@ void CharacteristicWriteProcessor2AD9::changeSlope(int16_t iresistance) {
       if(!((bike*)Bike)->inclinationAvailableByHardware())
           Bike->setInclination(grade);
 
+      // with the virtual gearing the bike computes its target from the gear, the cadence and the road (a bike with a
+      // power model and no cadence yet gets the grade below)
+      if (((bike *)Bike)->setSimulationParameters(grade, windSpeed, crr))
+          return;
+
       if (iresistance >= 0 || !zwift_negative_inclination_x2)
           emit changeInclination(grade,
                                  ((qTan(qDegreesToRadians(iresistance / 100.0)) * 100.0) * gain) + offset);
@@ -16,7 +16,13 @@ class CharacteristicWriteProcessor2AD9 : public CharacteristicWriteProcessor {
     explicit CharacteristicWriteProcessor2AD9(double bikeResistanceGain, uint8_t bikeResistanceOffset,
                                               bluetoothdevice *bike, CharacteristicNotifier2AD9 *notifier, QObject *parent = nullptr);
     virtual int writeProcess(quint16 uuid, const QByteArray &data, QByteArray &out);
-    void changeSlope(int16_t slope);
+    /**
+     * @brief changeSlope The FTMS indoor bike simulation parameters.
+     * @param slope Grade, in 0.01 %
+     * @param windSpeed Head wind, in m/s
+     * @param crr Rolling resistance coefficient, 0 when unknown
+     */
+    void changeSlope(int16_t slope, double windSpeed = 0, double crr = 0);
     void changePower(uint16_t power);
   signals:
     void changeInclination(double grade, double percentage);
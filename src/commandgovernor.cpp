@@ -0,0 +1,25 @@
+#include "commandgovernor.h"
+
+bool commandgovernor::ready(double delta, double largeDelta) {
+    if (!lastCommand.isValid() || latency <= 0)
+        return true;
+    qint64 elapsed = lastCommand.elapsed();
+    if (elapsed >= interval())
+        return true;
+    return qAbs(delta) >= largeDelta && elapsed >= latency;
+}
+
+void commandgovernor::writing() { writeTime.start(); }
+
+void commandgovernor::written() {
+    if (!writeTime.isValid())
+        return;
+    qint64 ms = writeTime.elapsed();
+    writeTime.invalidate();
+    lastCommand.start();
+
+    if (latency <= 0)
+        latency = ms;
+    else
+        latency += alpha * (ms - latency);
+}
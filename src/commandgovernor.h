@@ -0,0 +1,42 @@
+#ifndef COMMANDGOVERNOR_H
+#define COMMANDGOVERNOR_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+/**
+ * @brief Limits the resistance and inclination commands to the rate a device can sustain, learned from the time its
+ * writes take to complete. The drivers keep a target pending until ready() and every new target replaces it, so the
+ * intermediate targets of a fast source (e.g. the simulation parameters of a game several times a second) collapse
+ * into the last one. A large change goes out sooner than a small one.
+ */
+class commandgovernor {
+  public:
+    /**
+     * @brief A target that changes the current value by delta can be written now.
+     * @param largeDelta The change that is written as soon as the previous command has been processed
+     */
+    bool ready(double delta, double largeDelta);
+
+    /**
+     * @brief Around the (blocking) writes of a command, to measure their completion latency.
+     */
+    void writing();
+    void written();
+
+    /**
+     * @brief The minimum time between two commands. Units: ms
+     */
+    qint64 interval() const { return qRound64(latency * headroom); }
+
+  private:
+    // the commands use at most a third of the time of the device, the rest is left for the polling
+    static constexpr double headroom = 3.0;
+    static constexpr double alpha = 0.3;
+
+    double latency = 0; // ms, moving average
+    QElapsedTimer writeTime;
+    QElapsedTimer lastCommand;
+};
+
+#endif // COMMANDGOVERNOR_H
@@ -3,6 +3,8 @@
 #include "qzsettings.h"
 #include <QSettings>
 
+QAtomicInt DirconProcessor::clientsCount;
+
 DirconProcessor::DirconProcessor(const QList<DirconProcessorService *> &my_services, const QString &serv_name,
                                  quint16 serv_port, const QString &serv_sn, const QString &my_mac, QObject *parent)
     : QObject(parent), services(my_services), mac(my_mac), serverPort(serv_port), serialN(serv_sn),
@@ -84,13 +86,15 @@ void DirconProcessor::tcpNewConnection() {
     connect(socket, SIGNAL(readyRead()), this, SLOT(tcpDataAvailable()));
     DirconProcessorClient *client = new DirconProcessorClient(socket);
     clientsMap.insert(socket, client);
+    clientsCount.ref();
 }
 
 void DirconProcessor::tcpDisconnected() {
     QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
     qDebug() << "Disconnection from" << socket->peerAddress().toString() << ":" << socket->peerPort()
              << " uuid = " << serverName;
-    clientsMap.remove(socket);
+    if (clientsMap.remove(socket))
+        clientsCount.deref();
     socket->deleteLater();
 }
 
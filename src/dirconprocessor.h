@@ -7,6 +7,7 @@
 #include "qmdnsengine/provider.h"
 #include "qmdnsengine/server.h"
 #include "qmdnsengine/service.h"
+#include <QAtomicInt>
 #include <QHash>
 #include <QObject>
 #include <QTcpServer>
@@ -81,6 +82,7 @@ class DirconProcessor : public QObject {
     QMdnsEngine::Provider *mdnsProvider = 0;
     QMdnsEngine::Hostname *mdnsHostname = 0;
     QHash<QTcpSocket *, DirconProcessorClient *> clientsMap;
+    static QAtomicInt clientsCount;
     bool initServer();
     void initAdvertising();
     DirconPacket processPacket(DirconProcessorClient *client, const DirconPacket &pkt);
@@ -91,6 +93,8 @@ class DirconProcessor : public QObject {
                              quint16 serv_port, const QString &serv_sn, const QString &mac, QObject *parent = nullptr);
     bool sendCharacteristicNotification(quint16 uuid, const QByteArray &data);
     bool init();
+    // clients connected to all the DirCon servers
+    static int connectedClients() { return clientsCount.load(); }
   private slots:
     void tcpDataAvailable();
     void tcpDisconnected();
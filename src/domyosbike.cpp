@@ -242,10 +242,14 @@ void domyosbike::update() {
                 } else if (requestResistance < 1) {
                     requestResistance = 1;
                 }
-
+            }
+            if (requestResistance != -1 &&
+                commandGovernor.ready(requestResistance - currentResistance().value(), max_resistance / 5)) {
                 if (requestResistance != currentResistance().value()) {
                     qDebug() << QStringLiteral("writing resistance ") + QString::number(requestResistance);
+                    commandGovernor.writing();
                     forceResistance(requestResistance);
+                    commandGovernor.written();
                 }
                 requestResistance = -1;
             }
@@ -649,21 +653,25 @@ void *domyosbike::VirtualDevice() { return VirtualBike(); }
 resistance_t domyosbike::pelotonToBikeResistance(int pelotonResistance) { return (pelotonResistance * max_resistance) / 100; }
 
 resistance_t domyosbike::resistanceFromPowerRequest(uint16_t power) {
-    qDebug() << QStringLiteral("resistanceFromPowerRequest") << currentCadence().value();
-
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            return i;
-        }
+    if (!ergTable.isBuiltFor(1, max_resistance)) {
+        ergTable.build(1, max_resistance, [this](double cadence, resistance_t resistance) {
+            return wattsFromResistance(resistance, cadence);
+        });
     }
-    if (power < wattsFromResistance(1))
+    double cadence = currentCadence().value();
+    const powercalibration &calibration = powerCalibration();
+    int r = ergTable.resistanceFromPower(power, cadence, 1, max_resistance, calibration.gain(cadence),
+                                         calibration.offset());
+    if (r != -1)
+        return r;
+    if (power < calibration.apply(cadence, ergTable.watts(cadence, 1)))
         return 1;
     else
         return max_resistance;
 }
 
-uint16_t domyosbike::wattsFromResistance(double resistance) {
-    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+uint16_t domyosbike::wattsFromResistance(double resistance, double cadence) {
+    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (cadence))));
 }
 
 uint16_t domyosbike::watts() {
@@ -675,13 +683,14 @@ uint16_t domyosbike::watts() {
     if (currentCadence().value() <= 0) {
         return 0;
     }
-    v = wattsFromResistance(currentResistance().value());
+    v = powerCalibration().apply(currentCadence().value(), wattsFromResistance(currentResistance().value()));
     return v;
 }
 
 void domyosbike::controllerStateChanged(QLowEnergyController::ControllerState state) {
     qDebug() << QStringLiteral("controllerStateChanged") << state;
     if (state == QLowEnergyController::UnconnectedState && m_control) {
+        ergTable.clear();
         qDebug() << QStringLiteral("trying to connect back again...");
         initDone = false;
         m_control->connectToDevice();
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "bike.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -39,8 +40,11 @@ class domyosbike : public bike {
     domyosbike(bool noWriteResistance = false, bool noHeartService = false, bool testResistance = false,
                uint8_t bikeResistanceOffset = 4, double bikeResistanceGain = 1.0);
     resistance_t resistanceFromPowerRequest(uint16_t power);
+    bool hasResistancePowerModel() { return true; }
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(double resistance, double cadence);
     ~domyosbike();
     bool connected();
 
@@ -52,7 +56,11 @@ class domyosbike : public bike {
     double GetInclinationFromPacket(QByteArray packet);
     double GetKcalFromPacket(const QByteArray &packet);
     double GetDistanceFromPacket(const QByteArray &packet);
-    uint16_t wattsFromResistance(double resistance);
+    uint16_t wattsFromResistance(double resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     void forceResistance(resistance_t requestResistance);
     void updateDisplay(uint16_t elapsed);
     void btinit_changyow(bool startTape);
@@ -307,7 +307,9 @@ void domyostreadmill::update() {
                         inc = requestInclination;
                         requestInclination = -100;
                     }
+                    commandGovernor.writing();
                     forceSpeedOrIncline(requestSpeed, inc);
+                    commandGovernor.written();
                 }
                 requestSpeed = -1;
             }
@@ -316,6 +318,9 @@ void domyostreadmill::update() {
                     requestInclination = 0;
                 // only 0.5 steps ara avaiable
                 requestInclination = qRound(requestInclination * 2.0) / 2.0;
+            }
+            if (requestInclination != -100 &&
+                commandGovernor.ready(requestInclination - currentInclination().value(), 2.0)) {
                 if (requestInclination != currentInclination().value() && requestInclination >= 0 &&
                     requestInclination <= 15) {
                     emit debug(QStringLiteral("writing incline ") + QString::number(requestInclination));
@@ -326,7 +331,9 @@ void domyostreadmill::update() {
                         speed = requestSpeed;
                         requestSpeed = -1;
                     }
+                    commandGovernor.writing();
                     forceSpeedOrIncline(speed, requestInclination);
+                    commandGovernor.written();
                 }
                 requestInclination = -100;
             }
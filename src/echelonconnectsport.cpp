@@ -164,19 +164,21 @@ resistance_t echelonconnectsport::pelotonToBikeResistance(int pelotonResistance)
 }
 
 resistance_t echelonconnectsport::resistanceFromPowerRequest(uint16_t power) {
-    qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
-
     if (Cadence.value() == 0)
         return 1;
 
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
+    if (!ergTable.isBuiltFor(1, max_resistance)) {
+        ergTable.build(1, max_resistance, [this](double cadence, resistance_t resistance) {
+            return wattsFromResistance(resistance, cadence);
+        });
     }
-    if (power < wattsFromResistance(1))
+    double cadence = currentCadence().value();
+    const powercalibration &calibration = powerCalibration();
+    int r = ergTable.resistanceFromPower(power, cadence, 1, max_resistance, calibration.gain(cadence),
+                                         calibration.offset());
+    if (r != -1)
+        return r;
+    if (power < calibration.apply(cadence, ergTable.watts(cadence, 1)))
         return 1;
     else
         return max_resistance;
@@ -511,10 +513,10 @@ uint16_t echelonconnectsport::watts() {
     if (currentCadence().value() == 0) {
         return 0;
     }
-    return wattsFromResistance(Resistance.value());
+    return powerCalibration().apply(currentCadence().value(), wattsFromResistance(Resistance.value()));
 }
 
-uint16_t echelonconnectsport::wattsFromResistance(double resistance) {
+uint16_t echelonconnectsport::wattsFromResistance(double resistance, double cadence) {
     // https://github.com/cagnulein/qdomyos-zwift/issues/62#issuecomment-736913564
     /*if(currentCadence().value() < 90)
         return (uint16_t)((3.59 * exp(0.0217 * (double)(currentCadence().value()))) * exp(0.095 *
@@ -609,18 +611,19 @@ uint16_t echelonconnectsport::wattsFromResistance(double resistance) {
         watts_of_level = wattTable_mgarcea[level];
     else
         watts_of_level = wattTable[level];
-    int watt_setp = (Cadence.value() / 10.0);
+    int watt_setp = (cadence / 10.0);
     if (watt_setp >= 10) {
-        return (((double)Cadence.value()) / 100.0) * watts_of_level[wattTableSecondDimension - 1];
+        return (((double)cadence) / 100.0) * watts_of_level[wattTableSecondDimension - 1];
     }
     double watt_base = watts_of_level[watt_setp];
-    return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)(Cadence.value())) % 10))) +
+    return (((watts_of_level[watt_setp + 1] - watt_base) / 10.0) * ((double)(((int)(cadence)) % 10))) +
            watt_base;
 }
 
 void echelonconnectsport::controllerStateChanged(QLowEnergyController::ControllerState state) {
     qDebug() << QStringLiteral("controllerStateChanged") << state;
     if (state == QLowEnergyController::UnconnectedState && m_control) {
+        ergTable.clear();
         lastResistanceBeforeDisconnection = Resistance.value();
         qDebug() << QStringLiteral("trying to connect back again...");
         initDone = false;
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "bike.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -40,7 +41,10 @@ class echelonconnectsport : public bike {
                         double bikeResistanceGain);
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(double resistance, double cadence);
     resistance_t resistanceFromPowerRequest(uint16_t power);
+    bool hasResistancePowerModel() { return true; }
     bool connected();
 
     void *VirtualBike();
@@ -50,7 +54,11 @@ class echelonconnectsport : public bike {
     const resistance_t max_resistance = 32;
     double bikeResistanceToPeloton(double resistance);
     double GetDistanceFromPacket(const QByteArray &packet);
-    uint16_t wattsFromResistance(double resistance);
+    uint16_t wattsFromResistance(double resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     QTime GetElapsedFromPacket(const QByteArray &packet);
     void btinit();
     void writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log = false,
@@ -165,15 +165,17 @@ resistance_t echelonrower::pelotonToBikeResistance(int pelotonResistance) {
 }
 
 resistance_t echelonrower::resistanceFromPowerRequest(uint16_t power) {
-    qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
-
-    for (resistance_t i = 1; i < max_resistance - 1; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
+    if (!ergTable.isBuiltFor(1, max_resistance)) {
+        ergTable.build(1, max_resistance, [this](double cadence, resistance_t resistance) {
+            return wattsFromResistance(resistance, cadence);
+        });
     }
+    double cadence = currentCadence().value();
+    const powercalibration &calibration = powerCalibration();
+    int r = ergTable.resistanceFromPower(power, cadence, 1, max_resistance - 1, calibration.gain(cadence),
+                                         calibration.offset());
+    if (r != -1)
+        return r;
     return Resistance.value();
 }
 
@@ -503,10 +505,10 @@ uint16_t echelonrower::watts() {
     if (currentCadence().value() == 0) {
         return 0;
     }
-    return wattsFromResistance(Resistance.value());
+    return powerCalibration().apply(currentCadence().value(), wattsFromResistance(Resistance.value()));
 }
 
-uint16_t echelonrower::wattsFromResistance(double resistance) {
+uint16_t echelonrower::wattsFromResistance(double resistance, double cadence) {
     // https://github.com/cagnulein/qdomyos-zwift/issues/62#issuecomment-736913564
     /*if(currentCadence().value() < 90)
         return (uint16_t)((3.59 * exp(0.0217 * (double)(currentCadence().value()))) * exp(0.095 *
@@ -560,17 +562,18 @@ uint16_t echelonrower::wattsFromResistance(double resistance) {
         level = wattTableFirstDimension - 1;
     }
     double *watts_of_level = wattTable[level];
-    int watt_setp = (Cadence.value() / 5.0);
+    int watt_setp = (cadence / 5.0);
     if (watt_setp >= 11) {
-        return (((double)Cadence.value()) / 55.0) * watts_of_level[wattTableSecondDimension - 1];
+        return (((double)cadence) / 55.0) * watts_of_level[wattTableSecondDimension - 1];
     }
     double watt_base = watts_of_level[watt_setp];
-    return (((watts_of_level[watt_setp + 1] - watt_base) / 5.0) * ((double)(((int)(Cadence.value())) % 5))) + watt_base;
+    return (((watts_of_level[watt_setp + 1] - watt_base) / 5.0) * ((double)(((int)(cadence)) % 5))) + watt_base;
 }
 
 void echelonrower::controllerStateChanged(QLowEnergyController::ControllerState state) {
     qDebug() << QStringLiteral("controllerStateChanged") << state;
     if (state == QLowEnergyController::UnconnectedState && m_control) {
+        ergTable.clear();
         lastResistanceBeforeDisconnection = Resistance.value();
         qDebug() << QStringLiteral("trying to connect back again...");
         initDone = false;
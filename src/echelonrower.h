@@ -28,6 +28,7 @@
 
 #include "rower.h"
 #include "virtualbike.h"
+#include "ergtable.h"
 #include "virtualrower.h"
 
 #ifdef Q_OS_IOS
@@ -41,6 +42,8 @@ class echelonrower : public rower {
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t resistanceFromPowerRequest(uint16_t power);
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(double resistance, double cadence);
     bool connected();
 
     void *VirtualBike();
@@ -50,7 +53,11 @@ class echelonrower : public rower {
     const resistance_t max_resistance = 32;
     double bikeResistanceToPeloton(double resistance);
     double GetDistanceFromPacket(const QByteArray &packet);
-    uint16_t wattsFromResistance(double resistance);
+    uint16_t wattsFromResistance(double resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     QTime GetElapsedFromPacket(const QByteArray &packet);
     void btinit();
     void writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log = false,
@@ -64,6 +64,7 @@ void elliptical::changeInclination(double grade, double inclination) {
     Q_UNUSED(grade);
     if (autoResistanceEnable) {
         requestInclination = inclination;
+        learnInclinationCommand(inclination);
     }
 }
 double elliptical::currentCrankRevolutions() { return CrankRevs; }
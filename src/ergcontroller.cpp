@@ -0,0 +1,97 @@
+#include "ergcontroller.h"
+#include <QtGlobal>
+#include <QtMath>
+
+void ergcontroller::setLimits(double minResistance, double maxResistance) {
+    this->minResistance = minResistance;
+    this->maxResistance = qMax(minResistance, maxResistance);
+}
+
+void ergcontroller::setSettlingTime(double seconds) {
+    // with a static model error the loop is first order with tau = (1 + kp) / ki, 2% band at 4 tau
+    if (seconds > 0)
+        ki = 4.0 * (1.0 + kp) / seconds;
+}
+
+void ergcontroller::setGains(double kp, double ki) {
+    this->kp = qMax(0.0, kp);
+    this->ki = qMax(0.0, ki);
+}
+
+void ergcontroller::setTarget(double watts) {
+    if (watts == targetWatts)
+        return;
+    stepFrom = targetWatts;
+    targetWatts = watts;
+    stepTime = 0;
+    overshoot = 0;
+    settledAt = 0;
+    // the measured power needs some time to follow the new level of the feed-forward
+    holdRemaining = holdTime;
+}
+
+void ergcontroller::reset() {
+    integral = 0;
+    corr = 0;
+    out = 0;
+    lastCadence = -1;
+    holdRemaining = 0;
+    targetWatts = 0;
+    stepFrom = 0;
+    stepTime = 0;
+    overshoot = 0;
+    settledAt = 0;
+}
+
+double ergcontroller::levelsPerWatt() {
+    // local slope of the model around the target, the last good one when the levels are too coarse to see it
+    double delta = qMax(20.0, targetWatts * 0.1);
+    double s = (feedForward(targetWatts + delta) - feedForward(qMax(0.0, targetWatts - delta))) / (2.0 * delta);
+    if (s > 0)
+        slope = s;
+    return slope;
+}
+
+double ergcontroller::update(double measuredWatts, double cadence, double dt) {
+    if (!feedForward || targetWatts <= 0)
+        return out;
+
+    double ff = feedForward(targetWatts);
+    double error = targetWatts - measuredWatts;
+
+    if (lastCadence >= 0 && qAbs(cadence - lastCadence) > cadenceStep)
+        holdRemaining = holdTime;
+    lastCadence = cadence;
+    bool hold = cadence < minCadence || holdRemaining > 0 || dt <= 0;
+    holdRemaining = qMax(0.0, holdRemaining - dt);
+
+    if (!hold) {
+        // a change smaller than a quarter of level would only make the bike hunt between two levels
+        double s = levelsPerWatt();
+        double e = qAbs(error) <= qMax(deadband, 0.25 / s) ? 0 : error * s;
+        double newIntegral = integral + ki * e * dt;
+        double wanted = kp * e + newIntegral;
+
+        double limited = qBound(corr - maxRate * dt, wanted, corr + maxRate * dt);
+        double total = ff + limited;
+        if (total > maxResistance)
+            limited = maxResistance - ff;
+        else if (total < minResistance)
+            limited = minResistance - ff;
+
+        // back-calculation: the integral never runs ahead of what the actuator has really done
+        if (limited != wanted)
+            newIntegral = limited - kp * e;
+        integral = newIntegral;
+        corr = limited;
+    }
+    out = qBound(minResistance, ff + corr, maxResistance);
+
+    stepTime += dt;
+    double step = targetWatts - stepFrom;
+    if (qAbs(step) > 0)
+        overshoot = qMax(overshoot, (measuredWatts - targetWatts) / step);
+    if (qAbs(error) > qMax(targetWatts * 0.05, 5.0))
+        settledAt = stepTime;
+    return out;
+}
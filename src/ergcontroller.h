@@ -0,0 +1,79 @@
+#ifndef ERGCONTROLLER_H
+#define ERGCONTROLLER_H
+
+#include <functional>
+
+/**
+ * @brief ERG mode for the bikes that only have resistance levels. The feed-forward maps the target power to a
+ * resistance level with the model of the bike (resistanceFromPowerRequest), a PI loop on the measured power trims
+ * the error of the model. The correction is rate limited, it is not integrated while the output is saturated and
+ * it is frozen for a while after a cadence or a target change, since the measured power follows them with some delay.
+ */
+class ergcontroller {
+  public:
+    typedef std::function<double(double power)> feedForwardFunction;
+
+    ergcontroller() { setSettlingTime(12.0); }
+
+    void setFeedForward(const feedForwardFunction &f) { feedForward = f; }
+    void setLimits(double minResistance, double maxResistance);
+    /**
+     * @brief The time (s) to bring the power within 2% of the target with a static model error. It sets the integral
+     * gain as ki = 4 * (1 + kp) / settlingTime.
+     */
+    void setSettlingTime(double seconds);
+    void setGains(double kp, double ki);
+    /**
+     * @brief Max change of the correction, in resistance levels per second.
+     */
+    void setMaxRate(double levelsPerSecond) { maxRate = levelsPerSecond; }
+    void setDeadband(double watts) { deadband = watts; }
+    void setTarget(double watts);
+    double target() const { return targetWatts; }
+    void reset();
+
+    /**
+     * @brief Run a step of the loop.
+     * @param measuredWatts The power read from the bike or from the power meter
+     * @param cadence The current cadence, under 20 rpm the correction is held
+     * @param dt The time from the previous step, in seconds
+     * @return The resistance level to request
+     */
+    double update(double measuredWatts, double cadence, double dt);
+    double output() const { return out; }
+    double correction() const { return corr; }
+
+    // step response of the current target: max overshoot (fraction of the step) and settling time (s)
+    double stepOvershoot() const { return overshoot; }
+    double stepSettlingTime() const { return settledAt; }
+
+  private:
+    double levelsPerWatt();
+
+    feedForwardFunction feedForward;
+    double minResistance = 0;
+    double maxResistance = 100;
+    double kp = 0.5;
+    double ki = 0.5;
+    double maxRate = 1.0;
+    double deadband = 3.0;
+    double minCadence = 20.0;
+    double cadenceStep = 8.0;
+    // seconds without integration after a cadence or a target change
+    double holdTime = 3.0;
+
+    double targetWatts = 0;
+    double integral = 0;
+    double corr = 0;
+    double out = 0;
+    double lastCadence = -1;
+    double holdRemaining = 0;
+    double slope = 0.05;
+
+    double stepFrom = 0;
+    double stepTime = 0;
+    double overshoot = 0;
+    double settledAt = 0;
+};
+
+#endif // ERGCONTROLLER_H
@@ -0,0 +1,88 @@
+#include "ergtable.h"
+#include <QtMath>
+
+void ergtable::build(resistance_t minResistance, resistance_t maxResistance, const wattsFunction &watts,
+                     int maxCadence) {
+    formula = watts;
+    this->minResistance = minResistance;
+    this->maxResistance = qMax(minResistance, maxResistance);
+    this->maxCadence = qMax(1, maxCadence);
+    columns = this->maxResistance - minResistance + 1;
+    table.resize((this->maxCadence + 1) * columns);
+    rowAscending.fill(true, this->maxCadence + 1);
+    for (int cadence = 0; cadence <= this->maxCadence; cadence++) {
+        double *row = table.data() + cadence * columns;
+        for (int i = 0; i < columns; i++) {
+            row[i] = formula(cadence, minResistance + i);
+            if (i > 0 && row[i] < row[i - 1])
+                rowAscending[cadence] = false;
+        }
+    }
+}
+
+void ergtable::clear() {
+    table.clear();
+    rowAscending.clear();
+    formula = nullptr;
+}
+
+double ergtable::levelWatts(double cadence, resistance_t resistance) const {
+    // the formulas truncate the watts, so an interpolation between two rows doesn't give the level of the formula
+    if (cadence < 0 || cadence > maxCadence || qIsNaN(cadence) || cadence != (int)cadence)
+        return formula(cadence, resistance);
+    return table.at((int)cadence * columns + (resistance - minResistance));
+}
+
+bool ergtable::ascending(double cadence) const {
+    if (cadence < 0 || cadence > maxCadence || qIsNaN(cadence))
+        return false;
+    int row = (int)cadence;
+    return rowAscending[row] && (row == cadence || rowAscending[row + 1]);
+}
+
+double ergtable::watts(double cadence, double resistance) const {
+    if (table.isEmpty())
+        return 0;
+    resistance = qBound((double)minResistance, resistance, (double)maxResistance);
+    resistance_t r = (resistance_t)qFloor(resistance);
+    double t = resistance - r;
+    double w = levelWatts(cadence, r);
+    if (t == 0)
+        return w;
+    return w + (levelWatts(cadence, r + 1) - w) * t;
+}
+
+int ergtable::resistanceFromPower(double power, double cadence, resistance_t first, resistance_t last, double gain,
+                                  double offset) const {
+    if (table.isEmpty())
+        return -1;
+    first = qMax(first, minResistance);
+    last = qMin(last, maxResistance);
+    if (last <= first)
+        return -1;
+    auto level = [&](resistance_t r) { return levelWatts(cadence, r) * gain + offset; };
+
+    if (gain < 0 || !ascending(cadence)) {
+        for (resistance_t i = first; i < last; i++) {
+            if (level(i) <= power && level(i + 1) >= power)
+                return i;
+        }
+        return -1;
+    }
+
+    // first level with watts >= power: the level below it is the first one of the linear scan
+    resistance_t lo = first;
+    resistance_t hi = last + 1;
+    while (lo < hi) {
+        resistance_t mid = lo + (hi - lo) / 2;
+        if (level(mid) < power)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo > last)
+        return -1;
+    if (lo > first)
+        return lo - 1;
+    return level(first) <= power ? first : -1;
+}
@@ -0,0 +1,52 @@
+#ifndef ERGTABLE_H
+#define ERGTABLE_H
+
+#include "definitions.h"
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Power of a bike for every cadence (1 rpm steps) and resistance level, computed once from the watts formula
+ * of the bike so the ERG mode can map a power request to a resistance level without evaluating the formula at every
+ * level. Fractional cadences and the cadences out of the table are evaluated with the formula, fractional resistances
+ * are interpolated between the nearest levels.
+ */
+class ergtable {
+  public:
+    typedef std::function<double(double cadence, resistance_t resistance)> wattsFunction;
+
+    void build(resistance_t minResistance, resistance_t maxResistance, const wattsFunction &watts,
+               int maxCadence = 200);
+    void clear();
+    bool isBuiltFor(resistance_t minResistance, resistance_t maxResistance) const {
+        return !table.isEmpty() && minResistance == this->minResistance && maxResistance == this->maxResistance;
+    }
+
+    /**
+     * @brief The power at a cadence and resistance, interpolated between the nearest levels.
+     */
+    double watts(double cadence, double resistance) const;
+    /**
+     * @brief The same search of the linear scans of the bikes: the first level i in [first, last) where
+     * watts(i) <= power <= watts(i + 1), -1 when the power is not in the range. The watts are scaled by gain and
+     * offset before the comparison. When the levels are in ascending order it is a binary search.
+     */
+    int resistanceFromPower(double power, double cadence, resistance_t first, resistance_t last, double gain = 1.0,
+                            double offset = 0.0) const;
+
+  private:
+    double levelWatts(double cadence, resistance_t resistance) const;
+    bool ascending(double cadence) const;
+
+    wattsFunction formula;
+    resistance_t minResistance = 0;
+    resistance_t maxResistance = 0;
+    int maxCadence = 0;
+    int columns = 0;
+    // row by cadence, column by resistance level
+    QVector<double> table;
+    // true when the power of the row never decreases as the resistance goes up
+    QVector<bool> rowAscending;
+};
+
+#endif // ERGTABLE_H
@@ -28,6 +28,12 @@ fakebike::fakebike(bool noWriteResistance, bool noHeartService, bool noVirtualDe
     refresh->start(200ms);
 }
 
+double fakebike::ergSimulationPower(double watts, double resistance) {
+    // test bench for the ERG mode: a rider at 85 rpm on a bike that makes 15% + 10W more than its model
+    // (resistanceFromPowerRequest gives power / 10), read by a power meter with a 2 seconds lag
+    return watts + ((resistance * 10.0 * 1.15 + 10.0) - watts) * 0.1;
+}
+
 void fakebike::update() {
     QSettings settings;
     QString heartRateBeltName =
@@ -46,7 +52,14 @@ void fakebike::update() {
 
     Speed = metric::calculateSpeedFromPower(w, Inclination.value(), Speed.value(),fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), speedLimit());*/
 
-    update_metrics(true, watts());
+    double w = watts();
+    if (settings.value(QZSettings::fakebike_erg_simulation, QZSettings::default_fakebike_erg_simulation).toBool()) {
+        Cadence = 85;
+        Speed = 30;
+        ergSimulationWatts = ergSimulationPower(ergSimulationWatts, Resistance.value());
+        w = ergSimulationWatts;
+    }
+    update_metrics(true, w);
 
     Distance += ((Speed.value() / (double)3600.0) /
                  ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
@@ -39,6 +39,10 @@ class fakebike : public bike {
   public:
     fakebike(bool noWriteResistance, bool noHeartService, bool noVirtualDevice);
     bool connected();
+    /**
+     * @brief One update (200 ms) of the ERG simulation: the power read after the previous one at a resistance level.
+     */
+    static double ergSimulationPower(double watts, double resistance);
 
     void *VirtualBike();
     void *VirtualDevice();
@@ -63,6 +67,9 @@ class fakebike : public bike {
     uint16_t oldLastCrankEventTime = 0;
     uint16_t oldCrankRevs = 0;
 
+    // power of the ERG simulation, see fakebike_erg_simulation
+    double ergSimulationWatts = 0;
+
 #ifdef Q_OS_IOS
     lockscreen *h = 0;
 #endif
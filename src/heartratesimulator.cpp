@@ -0,0 +1,78 @@
+#include "heartratesimulator.h"
+#include <QtMath>
+
+void heartratesimulator::step(double intensity, double dt) {
+    intensity = qBound(0.0, intensity, 1.2);
+    // the drift grows only during the hard efforts and it is slowly recovered at rest
+    if (intensity > 0.5)
+        driftAccumulated += drift * intensity * dt / 60.0;
+    else
+        driftAccumulated = qMax(0.0, driftAccumulated - drift * dt / 60.0);
+    double target = rest + (max - rest) * intensity + driftAccumulated;
+    double tau = target > hr ? tauUp : tauDown;
+    hr += (target - hr) * (1.0 - qExp(-dt / tau));
+    hr = qBound(rest, hr, max);
+}
+
+double heartratesimulator::zone(const double thresholds[4]) const {
+    double perc = hr * 100.0 / max;
+    double low = 0;
+    for (int i = 0; i < 4; i++) {
+        if (perc < thresholds[i])
+            return qMin(i + 1 + (perc - low) / (thresholds[i] - low), i + 1.9999);
+        low = thresholds[i];
+    }
+    return 5;
+}
+
+double heartratesimulator::intensity(heartratezonecontroller::ACTUATOR actuator, double value) const {
+    const double weight = 75.0;
+    double vo2 = 3.5;
+    switch (actuator) {
+    case heartratezonecontroller::SPEED:
+    case heartratezonecontroller::INCLINATION: {
+        // the inclination is simulated at 6 km/h, the speed at 1% of inclination
+        double speed = actuator == heartratezonecontroller::SPEED ? value : 6.0;
+        double grade = (actuator == heartratezonecontroller::SPEED ? 1.0 : value) / 100.0;
+        double v = speed * 1000.0 / 60.0; // m/min
+        if (speed < 8.0)
+            vo2 = 3.5 + 0.1 * v + 1.8 * v * grade;
+        else
+            vo2 = 3.5 + 0.2 * v + 0.9 * v * grade;
+        break;
+    }
+    case heartratezonecontroller::RESISTANCE:
+        // 12 W per level at a steady cadence
+        vo2 = 7.0 + 10.8 * (value * 12.0) / weight;
+        break;
+    case heartratezonecontroller::POWER:
+        vo2 = 7.0 + 10.8 * value / weight;
+        break;
+    }
+    return (vo2 - 3.5) / (vo2max - 3.5);
+}
+
+heartratesimulator::result heartratesimulator::run(heartratezonecontroller &controller,
+                                                   heartratezonecontroller::ACTUATOR actuator, double startValue,
+                                                   double targetZone, const double thresholds[4], uint32_t seconds,
+                                                   uint32_t warmUp) {
+    result r;
+    double value = startValue;
+    uint32_t inZone = 0;
+    controller.reset();
+    for (uint32_t t = 0; t < seconds; t++) {
+        step(intensity(actuator, value), 1.0);
+        double z = zone(thresholds);
+        double v;
+        if (controller.update(t, targetZone, z, value, &v)) {
+            value = v;
+            r.actuatorChanges++;
+        }
+        if (t >= warmUp && qFloor(z) == qFloor(targetZone))
+            inZone++;
+    }
+    r.inZone = seconds > warmUp ? (double)inZone / (double)(seconds - warmUp) : 0;
+    r.finalHeart = hr;
+    r.finalActuator = value;
+    return r;
+}
@@ -0,0 +1,64 @@
+#ifndef HEARTRATESIMULATOR_H
+#define HEARTRATESIMULATOR_H
+
+#include "heartratezonecontroller.h"
+#include <QString>
+
+/**
+ * @brief A simple model of the heart rate response to the exercise, to tune the heart zone controller offline.
+ * The steady state heart rate is linear with the relative intensity (VO2 reserve) of the effort, the heart rate
+ * reaches it with a first order response (faster going up than going down) plus the cardiac drift of the long
+ * efforts.
+ */
+class heartratesimulator {
+  public:
+    struct result {
+        double inZone = 0;        // fraction of the time in the target zone, after the warm up
+        double finalHeart = 0;    // bpm
+        double finalActuator = 0; // value of the actuator at the end
+        int actuatorChanges = 0;
+    };
+
+    heartratesimulator(double restHeart = 60.0, double maxHeart = 190.0) : rest(restHeart), max(maxHeart) {
+        hr = restHeart;
+    }
+
+    void setTimeConstants(double upSeconds, double downSeconds) {
+        tauUp = upSeconds;
+        tauDown = downSeconds;
+    }
+    void setDrift(double bpmPerMinute) { drift = bpmPerMinute; }
+    void setVO2Max(double vo2) { vo2max = vo2; }
+
+    /**
+     * @brief Advance the model of dt seconds at a relative intensity (0 rest, 1 max effort).
+     */
+    void step(double intensity, double dt);
+    double heart() const { return hr; }
+    /**
+     * @brief The heart zone as homeform computes it, with the zone thresholds in % of the max heart rate.
+     */
+    double zone(const double thresholds[4]) const;
+
+    // relative intensity of the actuators (ACSM equations for the running, 75 kg rider on the bike)
+    double intensity(heartratezonecontroller::ACTUATOR actuator, double value) const;
+
+    /**
+     * @brief Run a controller against the model at accelerated time, one sample per simulated second.
+     * @param warmUp Seconds excluded from the time in zone
+     */
+    result run(heartratezonecontroller &controller, heartratezonecontroller::ACTUATOR actuator, double startValue,
+               double targetZone, const double thresholds[4], uint32_t seconds, uint32_t warmUp = 600);
+
+  private:
+    double rest;
+    double max;
+    double hr;
+    double tauUp = 30.0;
+    double tauDown = 60.0;
+    double drift = 0.15;
+    double driftAccumulated = 0;
+    double vo2max = 45.0;
+};
+
+#endif // HEARTRATESIMULATOR_H
@@ -0,0 +1,77 @@
+#include "heartratezonecontroller.h"
+#include <QtMath>
+
+void heartratezonecontroller::setGains(double kp, double ki, double kd) {
+    this->kp = kp;
+    this->ki = ki;
+    this->kd = kd;
+}
+
+void heartratezonecontroller::setActuator(ACTUATOR actuator, double step, double minValue, double maxValue,
+                                          uint32_t creepCycles) {
+    if (actuator != act)
+        reset();
+    act = actuator;
+    this->step = step;
+    this->minValue = minValue;
+    this->maxValue = qMax(minValue, maxValue);
+    this->creepCycles = creepCycles;
+}
+
+void heartratezonecontroller::reset() {
+    started = false;
+    lastSeconds = 0;
+    e1 = 0;
+    e2 = 0;
+    inZoneCounter = 0;
+}
+
+bool heartratezonecontroller::update(uint32_t seconds, double targetZone, double currentZone, double currentValue,
+                                     double *output) {
+    // a new workout
+    if (started && seconds < lastSeconds)
+        reset();
+    if (started && seconds - lastSeconds < sampleTime)
+        return false;
+
+    // the internal setpoint keeps the fraction of the steps, it follows the device when it is moved from elsewhere
+    if (!started || qAbs(currentValue - setpoint) > step * 1.5)
+        setpoint = currentValue;
+    started = true;
+    lastSeconds = seconds;
+
+    double e = qFloor(targetZone) - qFloor(currentZone);
+    double delta = step * (kp * (e - e1) + ki * e + kd * (e - 2 * e1 + e2));
+    e2 = e1;
+    e1 = e;
+
+    if (e == 0) {
+        inZoneCounter++;
+        if (creepCycles > 0 && inZoneCounter > creepCycles) {
+            delta = step;
+            inZoneCounter = 0;
+        }
+    } else {
+        inZoneCounter = 0;
+    }
+
+    delta = qBound(-step, delta, step);
+    double v = qBound(minValue, setpoint + delta, maxValue);
+    if (v == setpoint)
+        return false;
+    setpoint = v;
+    *output = v;
+    return true;
+}
+
+heartratezonecontroller::ACTUATOR heartratezonecontroller::actuatorFromString(const QString &name, bool treadmill) {
+    if (!name.compare(QStringLiteral("Speed")))
+        return SPEED;
+    if (!name.compare(QStringLiteral("Inclination")))
+        return INCLINATION;
+    if (!name.compare(QStringLiteral("Resistance")))
+        return RESISTANCE;
+    if (!name.compare(QStringLiteral("Power")))
+        return POWER;
+    return treadmill ? SPEED : RESISTANCE;
+}
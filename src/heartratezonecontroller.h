@@ -0,0 +1,65 @@
+#ifndef HEARTRATEZONECONTROLLER_H
+#define HEARTRATEZONECONTROLLER_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @brief Keeps the heart rate in a target zone moving one actuator of the device (speed, inclination, resistance or
+ * power). Every sample time it runs an incremental PID on the zone error (target zone - current zone, as integers):
+ * delta = step * (kp * (e - e1) + ki * e + kd * (e - 2 * e1 + e2)), limited to one step per sample and to the limits
+ * of the actuator. The default gains (kp 0, ki 1, kd 0) move the actuator of one step per sample while out of the
+ * zone, as the PID on heart zone always did.
+ */
+class heartratezonecontroller {
+  public:
+    enum ACTUATOR { SPEED, INCLINATION, RESISTANCE, POWER };
+
+    void setGains(double kp, double ki, double kd);
+    void setSampleTime(uint32_t seconds) { sampleTime = qMax(1u, seconds); }
+    /**
+     * @brief Set the actuator, its step and its limits.
+     * @param creepCycles After this many samples in the zone the actuator is moved up of one step, 0 to disable
+     */
+    void setActuator(ACTUATOR actuator, double step, double minValue, double maxValue, uint32_t creepCycles = 0);
+    ACTUATOR actuator() const { return act; }
+    void reset();
+
+    /**
+     * @brief Run the controller.
+     * @param seconds The elapsed time of the workout
+     * @param targetZone The zone to keep
+     * @param currentZone The current heart zone (see bluetoothdevice::currentHeartZone)
+     * @param currentValue The current value of the actuator, read from the device
+     * @param output The new value of the actuator
+     * @return true when the actuator has to be moved to output
+     */
+    bool update(uint32_t seconds, double targetZone, double currentZone, double currentValue, double *output);
+
+    /**
+     * @brief The actuator from the hr_zone_pid_actuator setting ("Auto", "Speed", "Inclination", "Resistance",
+     * "Power"), "Auto" is the speed on the treadmills and the resistance on the other devices (homeform moves no
+     * actuator of an elliptical with "Auto").
+     */
+    static ACTUATOR actuatorFromString(const QString &name, bool treadmill);
+
+  private:
+    double kp = 0;
+    double ki = 1;
+    double kd = 0;
+    uint32_t sampleTime = 10;
+    ACTUATOR act = RESISTANCE;
+    double step = 1;
+    double minValue = 0;
+    double maxValue = 100;
+    uint32_t creepCycles = 0;
+
+    bool started = false;
+    uint32_t lastSeconds = 0;
+    double setpoint = 0;
+    double e1 = 0;
+    double e2 = 0;
+    uint32_t inZoneCounter = 0;
+};
+
+#endif // HEARTRATEZONECONTROLLER_H
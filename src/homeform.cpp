@@ -16,6 +16,7 @@
 #include <QHttpMultiPart>
 #include <QImageWriter>
 #include <QJsonDocument>
+#include <QMetaProperty>
 #include <QNetworkAccessManager>
 #include <QOAuth2AuthorizationCodeFlow>
 #include <QOAuthHttpServerReplyHandler>
@@ -83,22 +84,33 @@ void DataObject::setName(const QString &v) {
     emit nameChanged(m_name);
 }
 void DataObject::setValue(const QString &v) {
+    // the qml side re-renders on every notification, so unchanged values are not notified
+    if (m_value == v)
+        return;
     m_value = v;
     emit valueChanged(m_value);
 }
 void DataObject::setSecondLine(const QString &value) {
+    if (m_secondLine == value)
+        return;
     m_secondLine = value;
     emit secondLineChanged(m_secondLine);
 }
 void DataObject::setValueFontSize(int value) {
+    if (m_valueFontSize == value)
+        return;
     m_valueFontSize = value;
     emit valueFontSizeChanged(m_valueFontSize);
 }
 void DataObject::setValueFontColor(const QString &value) {
+    if (m_valueFontColor == value)
+        return;
     m_valueFontColor = value;
     emit valueFontColorChanged(m_valueFontColor);
 }
 void DataObject::setLabelFontSize(int value) {
+    if (m_labelFontSize == value)
+        return;
     m_labelFontSize = value;
     emit labelFontSizeChanged(m_labelFontSize);
 }
@@ -246,6 +258,8 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     verticalOscillationMM =
         new DataObject(QStringLiteral("Vert.Osc.(mm)"), QStringLiteral("icons/icons/inclination.png"),
                        QStringLiteral("0"), false, QStringLiteral("vertical_oscillation"), 48, labelFontSize);
+    setupTileBindings();
+    loadUpdateSettings();
 
     if (!settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool()) {
 
@@ -296,13 +310,37 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
             &TemplateInfoSenderBuilder::workoutEventStateChanged);
     connect(bluetoothManager->getInnerTemplateManager(), &TemplateInfoSenderBuilder::activityDescriptionChanged, this,
             &homeform::setActivityDescription);
+    connect(bluetoothManager->getUserTemplateManager(), &TemplateInfoSenderBuilder::settingsChanged, this,
+            &homeform::settingsChanged);
+    connect(bluetoothManager->getInnerTemplateManager(), &TemplateInfoSenderBuilder::settingsChanged, this,
+            &homeform::settingsChanged);
+    // the Settings of the QML pages write QSettings a bit after their properties change, see watchSettings()
+    settingsChangedTimer.setSingleShot(true);
+    settingsChangedTimer.setInterval(1000);
+    connect(&settingsChangedTimer, &QTimer::timeout, this, &homeform::settingsChanged);
     engine->rootContext()->setContextProperty(QStringLiteral("rootItem"), (QObject *)this);
 
     this->trainProgram = new trainprogram(QList<trainrow>(), bl);
 
+    // the session sampler and the ui refresh run on independent timers: the sampler feeds the Session store (and so
+    // the fit file) at up to 10Hz, while the tiles can be throttled on slow devices
+    int sampleRate = qBound(1,
+                            settings.value(QZSettings::session_sample_rate_hz, QZSettings::default_session_sample_rate_hz)
+                                .toInt(),
+                            10);
+    int uiRefreshInterval =
+        qMax(1000, settings.value(QZSettings::ui_refresh_interval_ms, QZSettings::default_ui_refresh_interval_ms)
+                       .toInt());
+
+    chartModel = new workoutchartmodel(this);
+    sampleTimer = new QTimer(this);
+    sampleTimer->setTimerType(Qt::PreciseTimer);
+    connect(sampleTimer, &QTimer::timeout, this, &homeform::sample);
+    sampleTimer->start(1000 / sampleRate);
+
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &homeform::update);
-    timer->start(1s);
+    timer->start(uiRefreshInterval);
 
     backupTimer = new QTimer(this);
     connect(backupTimer, &QTimer::timeout, this, &homeform::backup);
@@ -378,6 +416,9 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
         }
     }
 
+    workoutLibrary = new workoutlibrary(getWritableAppDir() + QStringLiteral("workouts.idx"), this);
+    workoutLibrary->index(workoutFolders());
+
     m_speech.setLocale(QLocale::English);
 
 #if defined(Q_OS_LINUX) && !defined(Q_OS_ANDROID)
@@ -729,823 +770,321 @@ void homeform::ftmsAccessoryConnected(smartspin2k *d) {
     connect(d, &smartspin2k::gearDown, this, &homeform::gearDown);
 }
 
-void homeform::sortTiles() {
-
-    QSettings settings;
-    bool pelotoncadence =
-        settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-
-    if (!bluetoothManager || !bluetoothManager->device())
-        return;
-
-    dataList.clear();
-
-    if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
-        for (int i = 0; i < 100; i++) {
-            if (settings.value(QZSettings::tile_speed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_speed_order, 0).toInt() == i) {
-
-                speed->setGridId(i);
-                dataList.append(speed);
-            }
-
-            if (settings.value(QZSettings::tile_inclination_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_inclination_order, 0).toInt() == i) {
-                inclination->setGridId(i);
-                dataList.append(inclination);
-            }
-
-            if (settings.value(QZSettings::tile_elevation_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elevation_order, 0).toInt() == i) {
-                elevation->setGridId(i);
-                dataList.append(elevation);
-            }
-
-            if (settings.value(QZSettings::tile_elapsed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elapsed_order, 0).toInt() == i) {
-                elapsed->setGridId(i);
-                dataList.append(elapsed);
-            }
-
-            if (settings.value(QZSettings::tile_moving_time_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_moving_time_order, 19).toInt() == i) {
-                moving_time->setGridId(i);
-                dataList.append(moving_time);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_offset_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_offset_order, 20).toInt() == i) {
-                peloton_offset->setGridId(i);
-                dataList.append(peloton_offset);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_remaining_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_remaining_order, 20).toInt() == i) {
-                peloton_remaining->setGridId(i);
-                dataList.append(peloton_remaining);
-            }
-
-            if (settings.value(QZSettings::tile_calories_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_calories_order, 0).toInt() == i) {
-                calories->setGridId(i);
-                dataList.append(calories);
-            }
-
-            if (settings.value(QZSettings::tile_odometer_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_odometer_order, 0).toInt() == i) {
-                odometer->setGridId(i);
-                dataList.append(odometer);
-            }
-
-            if (settings.value(QZSettings::tile_pace_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_pace_order, 0).toInt() == i) {
-                pace->setGridId(i);
-                dataList.append(pace);
-            }
-
-            if (settings.value(QZSettings::tile_watt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_watt_order, 0).toInt() == i) {
-                watt->setGridId(i);
-                dataList.append(watt);
-            }
-
-            if (settings.value(QZSettings::tile_weight_loss_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_weight_loss_order, 24).toInt() == i) {
-                weightLoss->setGridId(i);
-                dataList.append(weightLoss);
-            }
-
-            if (settings.value(QZSettings::tile_avgwatt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_avgwatt_order, 0).toInt() == i) {
-                avgWatt->setGridId(i);
-                dataList.append(avgWatt);
-            }
-
-            if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
-                ftp->setGridId(i);
-                dataList.append(ftp);
-            }
-
-            if (settings.value(QZSettings::tile_jouls_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_jouls_order, 0).toInt() == i) {
-                jouls->setGridId(i);
-                dataList.append(jouls);
-            }
-
-            if (settings.value(QZSettings::tile_heart_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_heart_order, 0).toInt() == i) {
-                heart->setGridId(i);
-                dataList.append(heart);
-            }
-
-            if (settings.value(QZSettings::tile_fan_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_fan_order, 0).toInt() == i) {
-                fan->setGridId(i);
-                dataList.append(fan);
-            }
-
-            if (settings.value(QZSettings::tile_datetime_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_datetime_order, 0).toInt() == i) {
-                datetime->setGridId(i);
-                dataList.append(datetime);
-            }
-
-            if (settings.value(QZSettings::tile_lapelapsed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_lapelapsed_order, 18).toInt() == i) {
-                lapElapsed->setGridId(i);
-                dataList.append(lapElapsed);
-            }
-
-            if (settings.value(QZSettings::tile_watt_kg_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_watt_kg_order, 24).toInt() == i) {
-                wattKg->setGridId(i);
-                dataList.append(wattKg);
-            }
-
-            if (settings.value(QZSettings::tile_remainingtimetrainprogramrow_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_remainingtimetrainprogramrow_order, 27).toInt() == i) {
-
-                remaningTimeTrainingProgramCurrentRow->setGridId(i);
-                dataList.append(remaningTimeTrainingProgramCurrentRow);
-            }
-
-            if (settings.value(QZSettings::tile_nextrowstrainprogram_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_nextrowstrainprogram_order, 31).toInt() == i) {
-
-                nextRows->setGridId(i);
-                dataList.append(nextRows);
-            }
-
-            if (settings.value(QZSettings::tile_mets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_mets_order, 28).toInt() == i) {
-
-                mets->setGridId(i);
-                dataList.append(mets);
-            }
-            if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
-
-                targetMets->setGridId(i);
-                dataList.append(targetMets);
-            }
-
-            if (settings.value(QZSettings::tile_target_speed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_speed_order, 28).toInt() == i) {
-                target_speed->setGridId(i);
-                dataList.append(target_speed);
-            }
-
-            if (settings.value(QZSettings::tile_target_incline_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_incline_order, 29).toInt() == i) {
-                target_incline->setGridId(i);
-                dataList.append(target_incline);
-            }
-
-            if (settings.value(QZSettings::tile_cadence_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_cadence_order, 30).toInt() == i) {
-                cadence->setGridId(i);
-                dataList.append(cadence);
-            }
-
-            if (settings.value(QZSettings::tile_pid_hr_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_pid_hr_order, 31).toInt() == i) {
-                pidHR->setGridId(i);
-                dataList.append(pidHR);
-            }
-
-            if (settings.value(QZSettings::tile_instantaneous_stride_length_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_instantaneous_stride_length_order, 32).toInt() == i) {
-                instantaneousStrideLengthCM->setGridId(i);
-                dataList.append(instantaneousStrideLengthCM);
-            }
-
-            if (settings.value(QZSettings::tile_ground_contact_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_ground_contact_order, 33).toInt() == i) {
-                groundContactMS->setGridId(i);
-                dataList.append(groundContactMS);
-            }
-
-            if (settings.value(QZSettings::tile_vertical_oscillation_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_vertical_oscillation_order, 34).toInt() == i) {
-                verticalOscillationMM->setGridId(i);
-                dataList.append(verticalOscillationMM);
-            }
-        }
-    } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
-        for (int i = 0; i < 100; i++) {
-            if (settings.value(QZSettings::tile_speed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_speed_order, 0).toInt() == i) {
-
-                speed->setGridId(i);
-                dataList.append(speed);
-            }
-
-            if (settings.value(QZSettings::tile_cadence_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_cadence_order, 0).toInt() == i) {
-                cadence->setGridId(i);
-                dataList.append(cadence);
-            }
-
-            if (settings.value(QZSettings::tile_elevation_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elevation_order, 0).toInt() == i) {
-                elevation->setGridId(i);
-                dataList.append(elevation);
-            }
-
-            if (settings.value(QZSettings::tile_elapsed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elapsed_order, 0).toInt() == i) {
-                elapsed->setGridId(i);
-                dataList.append(elapsed);
-            }
-
-            if (settings.value(QZSettings::tile_moving_time_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_moving_time_order, 19).toInt() == i) {
-                moving_time->setGridId(i);
-                dataList.append(moving_time);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_offset_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_offset_order, 20).toInt() == i) {
-                peloton_offset->setGridId(i);
-                dataList.append(peloton_offset);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_remaining_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_remaining_order, 20).toInt() == i) {
-                peloton_remaining->setGridId(i);
-                dataList.append(peloton_remaining);
-            }
-
-            if (settings.value(QZSettings::tile_calories_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_calories_order, 0).toInt() == i) {
-                calories->setGridId(i);
-                dataList.append(calories);
-            }
-
-            if (settings.value(QZSettings::tile_odometer_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_odometer_order, 0).toInt() == i) {
-                odometer->setGridId(i);
-                dataList.append(odometer);
-            }
-
-            if (settings.value(QZSettings::tile_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_resistance_order, 0).toInt() == i) {
-                resistance->setGridId(i);
-                dataList.append(resistance);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_peloton_resistance_order, 0).toInt() == i) {
-                peloton_resistance->setGridId(i);
-                dataList.append(peloton_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_watt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_watt_order, 0).toInt() == i) {
-                watt->setGridId(i);
-                dataList.append(watt);
-            }
-
-            if (settings.value(QZSettings::tile_weight_loss_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_weight_loss_order, 24).toInt() == i) {
-                weightLoss->setGridId(i);
-                dataList.append(weightLoss);
-            }
-
-            if (settings.value(QZSettings::tile_avgwatt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_avgwatt_order, 0).toInt() == i) {
-                avgWatt->setGridId(i);
-                dataList.append(avgWatt);
-            }
-
-            if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
-                ftp->setGridId(i);
-                dataList.append(ftp);
-            }
-
-            if (settings.value(QZSettings::tile_jouls_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_jouls_order, 0).toInt() == i) {
-                jouls->setGridId(i);
-                dataList.append(jouls);
-            }
-
-            if (settings.value(QZSettings::tile_heart_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_heart_order, 0).toInt() == i) {
-                heart->setGridId(i);
-                dataList.append(heart);
-            }
-
-            if (settings.value(QZSettings::tile_fan_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_fan_order, 0).toInt() == i) {
-                fan->setGridId(i);
-                dataList.append(fan);
-            }
-
-            if (settings.value(QZSettings::tile_datetime_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_datetime_order, 0).toInt() == i) {
-                datetime->setGridId(i);
-                dataList.append(datetime);
-            }
-
-            if (settings.value(QZSettings::tile_target_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_target_resistance_order, 0).toInt() == i) {
-                target_resistance->setGridId(i);
-                dataList.append(target_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_target_peloton_resistance_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_peloton_resistance_order, 21).toInt() == i) {
-                target_peloton_resistance->setGridId(i);
-                dataList.append(target_peloton_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_target_cadence_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_cadence_order, 19).toInt() == i) {
-                target_cadence->setGridId(i);
-                dataList.append(target_cadence);
-            }
-
-            if (settings.value(QZSettings::tile_target_power_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_power_order, 20).toInt() == i) {
-                target_power->setGridId(i);
-                dataList.append(target_power);
-            }
-
-            if (settings.value(QZSettings::tile_target_zone_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_zone_order, 24).toInt() == i) {
-                target_zone->setGridId(i);
-                dataList.append(target_zone);
-            }
-
-            if (settings.value(QZSettings::tile_lapelapsed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_lapelapsed_order, 18).toInt() == i) {
-                lapElapsed->setGridId(i);
-                dataList.append(lapElapsed);
-            }
-
-            if (settings.value(QZSettings::tile_watt_kg_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_watt_kg_order, 24).toInt() == i) {
-                wattKg->setGridId(i);
-                dataList.append(wattKg);
-            }
-            if (settings.value(QZSettings::tile_gears_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_gears_order, 25).toInt() == i) {
-                gears->setGridId(i);
-                dataList.append(gears);
-            }
-
-            if (settings.value(QZSettings::tile_remainingtimetrainprogramrow_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_remainingtimetrainprogramrow_order, 27).toInt() == i) {
-
-                remaningTimeTrainingProgramCurrentRow->setGridId(i);
-                dataList.append(remaningTimeTrainingProgramCurrentRow);
-            }
-
-            if (settings.value(QZSettings::tile_nextrowstrainprogram_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_nextrowstrainprogram_order, 31).toInt() == i) {
-
-                nextRows->setGridId(i);
-                dataList.append(nextRows);
-            }
-
-            if (settings.value(QZSettings::tile_mets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_mets_order, 28).toInt() == i) {
-                mets->setGridId(i);
-                dataList.append(mets);
-            }
-            if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
-                targetMets->setGridId(i);
-                dataList.append(targetMets);
-            }
-            // the proform studio is the only bike managed with an inclination properties.
-            // In order to don't break the tiles layout to all the bikes users, i enable this
-            // only if this bike is selected
-            // since i'm adding the inclination from zwift in this tile, in order to preserve the
-            // layour for legacy users, i'm not showing this one if the peloton cadence sensor setting
-            // is enabled (assuming that if someone has it, he doesn't want an inclination tile)
-            if (!pelotoncadence) {
-                if (settings.value(QZSettings::tile_inclination_enabled, true).toBool() &&
-                    settings.value(QZSettings::tile_inclination_order, 29).toInt() == i) {
-                    inclination->setGridId(i);
-                    dataList.append(inclination);
-                }
-            }
-            if (settings.value(QZSettings::tile_steering_angle_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_steering_angle_order, 30).toInt() == i) {
-
-                steeringAngle->setGridId(i);
-                dataList.append(steeringAngle);
-            }
-
-            if (settings.value(QZSettings::tile_pid_hr_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_pid_hr_order, 31).toInt() == i) {
-                pidHR->setGridId(i);
-                dataList.append(pidHR);
-            }
-
-            if (settings.value(QZSettings::tile_ext_incline_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_ext_incline_order, 32).toInt() == i) {
-                extIncline->setGridId(i);
-                dataList.append(extIncline);
-            }
-        }
-    } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
-        for (int i = 0; i < 100; i++) {
-            if (settings.value(QZSettings::tile_speed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_speed_order, 0).toInt() == i) {
-                speed->setGridId(i);
-                dataList.append(speed);
-            }
-
-            if (settings.value(QZSettings::tile_cadence_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_cadence_order, 0).toInt() == i) {
-                cadence->setGridId(i);
-                cadence->setName("Stroke Rate");
-                dataList.append(cadence);
-            }
-
-            if (settings.value(QZSettings::tile_elevation_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elevation_order, 0).toInt() == i) {
-                elevation->setGridId(i);
-                dataList.append(elevation);
-            }
-
-            if (settings.value(QZSettings::tile_elapsed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elapsed_order, 0).toInt() == i) {
-                elapsed->setGridId(i);
-                dataList.append(elapsed);
-            }
-
-            if (settings.value(QZSettings::tile_moving_time_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_moving_time_order, 19).toInt() == i) {
-                moving_time->setGridId(i);
-                dataList.append(moving_time);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_offset_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_offset_order, 20).toInt() == i) {
-                peloton_offset->setGridId(i);
-                dataList.append(peloton_offset);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_remaining_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_remaining_order, 20).toInt() == i) {
-                peloton_remaining->setGridId(i);
-                dataList.append(peloton_remaining);
-            }
-
-            if (settings.value(QZSettings::tile_calories_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_calories_order, 0).toInt() == i) {
-                calories->setGridId(i);
-                dataList.append(calories);
-            }
-
-            if (settings.value(QZSettings::tile_odometer_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_odometer_order, 0).toInt() == i) {
-                odometer->setGridId(i);
-                odometer->setName("Odometer (m)");
-                dataList.append(odometer);
-            }
-
-            if (settings.value(QZSettings::tile_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_resistance_order, 0).toInt() == i) {
-                resistance->setGridId(i);
-                dataList.append(resistance);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_peloton_resistance_order, 0).toInt() == i) {
-                peloton_resistance->setGridId(i);
-                dataList.append(peloton_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_watt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_watt_order, 0).toInt() == i) {
-                watt->setGridId(i);
-                dataList.append(watt);
-            }
-
-            if (settings.value(QZSettings::tile_weight_loss_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_weight_loss_order, 24).toInt() == i) {
-                weightLoss->setGridId(i);
-                dataList.append(weightLoss);
-            }
-
-            if (settings.value(QZSettings::tile_avgwatt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_avgwatt_order, 0).toInt() == i) {
-                avgWatt->setGridId(i);
-                dataList.append(avgWatt);
-            }
-
-            if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
-                ftp->setGridId(i);
-                dataList.append(ftp);
-            }
-
-            if (settings.value(QZSettings::tile_jouls_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_jouls_order, 0).toInt() == i) {
-                jouls->setGridId(i);
-                dataList.append(jouls);
-            }
-
-            if (settings.value(QZSettings::tile_heart_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_heart_order, 0).toInt() == i) {
-                heart->setGridId(i);
-                dataList.append(heart);
-            }
-
-            if (settings.value(QZSettings::tile_fan_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_fan_order, 0).toInt() == i) {
-                fan->setGridId(i);
-                dataList.append(fan);
-            }
-
-            if (settings.value(QZSettings::tile_datetime_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_datetime_order, 0).toInt() == i) {
-                datetime->setGridId(i);
-                dataList.append(datetime);
-            }
-
-            if (settings.value(QZSettings::tile_target_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_target_resistance_order, 0).toInt() == i) {
-                target_resistance->setGridId(i);
-                dataList.append(target_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_target_peloton_resistance_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_peloton_resistance_order, 21).toInt() == i) {
-                target_peloton_resistance->setGridId(i);
-                dataList.append(target_peloton_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_target_cadence_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_cadence_order, 19).toInt() == i) {
-                target_cadence->setGridId(i);
-                dataList.append(target_cadence);
-            }
-
-            if (settings.value(QZSettings::tile_target_power_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_power_order, 20).toInt() == i) {
-                target_power->setGridId(i);
-                dataList.append(target_power);
-            }
-
-            if (settings.value(QZSettings::tile_lapelapsed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_lapelapsed_order, 18).toInt() == i) {
-                lapElapsed->setGridId(i);
-                dataList.append(lapElapsed);
-            }
-
-            if (settings.value(QZSettings::tile_strokes_length_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_strokes_length_order, 21).toInt() == i) {
-                strokesLength->setGridId(i);
-                dataList.append(strokesLength);
-            }
-
-            if (settings.value(QZSettings::tile_strokes_count_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_strokes_count_order, 22).toInt() == i) {
-                strokesCount->setGridId(i);
-                dataList.append(strokesCount);
-            }
-
-            if (settings.value(QZSettings::tile_pace_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_pace_order, 0).toInt() == i) {
-                pace->setGridId(i);
-                pace->setName("Pace (m/500m)");
-                dataList.append(pace);
-            }
-
-            if (settings.value(QZSettings::tile_watt_kg_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_watt_kg_order, 24).toInt() == i) {
-                wattKg->setGridId(i);
-                dataList.append(wattKg);
-            }
-
-            if (settings.value(QZSettings::tile_remainingtimetrainprogramrow_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_remainingtimetrainprogramrow_order, 27).toInt() == i) {
-                remaningTimeTrainingProgramCurrentRow->setGridId(i);
-                dataList.append(remaningTimeTrainingProgramCurrentRow);
-            }
-
-            if (settings.value(QZSettings::tile_nextrowstrainprogram_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_nextrowstrainprogram_order, 31).toInt() == i) {
-
-                nextRows->setGridId(i);
-                dataList.append(nextRows);
-            }
-
-            if (settings.value(QZSettings::tile_mets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_mets_order, 28).toInt() == i) {
-                mets->setGridId(i);
-                dataList.append(mets);
-            }
-            if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
-                targetMets->setGridId(i);
-                dataList.append(targetMets);
-            }
-
-            if (settings.value(QZSettings::tile_pid_hr_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_pid_hr_order, 31).toInt() == i) {
-                pidHR->setGridId(i);
-                dataList.append(pidHR);
-            }
-
-            if (settings.value(QZSettings::tile_target_zone_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_zone_order, 24).toInt() == i) {
-                target_zone->setGridId(i);
-                dataList.append(target_zone);
-            }
-        }
-    } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) {
-        for (int i = 0; i < 100; i++) {
-            if (settings.value(QZSettings::tile_speed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_speed_order, 0).toInt() == i) {
-                speed->setGridId(i);
-                dataList.append(speed);
-            }
-
-            if (settings.value(QZSettings::tile_cadence_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_cadence_order, 0).toInt() == i) {
-                cadence->setGridId(i);
-                dataList.append(cadence);
-            }
-
-            if (settings.value(QZSettings::tile_inclination_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_inclination_order, 0).toInt() == i) {
-                inclination->setGridId(i);
-                dataList.append(inclination);
-            }
-
-            if (settings.value(QZSettings::tile_elevation_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elevation_order, 0).toInt() == i) {
-                elevation->setGridId(i);
-                dataList.append(elevation);
-            }
-
-            if (settings.value(QZSettings::tile_elapsed_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_elapsed_order, 0).toInt() == i) {
-                elapsed->setGridId(i);
-                dataList.append(elapsed);
-            }
-
-            if (settings.value(QZSettings::tile_moving_time_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_moving_time_order, 19).toInt() == i) {
-                moving_time->setGridId(i);
-                dataList.append(moving_time);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_offset_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_offset_order, 20).toInt() == i) {
-                peloton_offset->setGridId(i);
-                dataList.append(peloton_offset);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_remaining_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_peloton_remaining_order, 20).toInt() == i) {
-                peloton_remaining->setGridId(i);
-                dataList.append(peloton_remaining);
-            }
-
-            if (settings.value(QZSettings::tile_calories_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_calories_order, 0).toInt() == i) {
-                calories->setGridId(i);
-                dataList.append(calories);
-            }
-
-            if (settings.value(QZSettings::tile_odometer_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_odometer_order, 0).toInt() == i) {
-                odometer->setGridId(i);
-                dataList.append(odometer);
-            }
-
-            if (settings.value(QZSettings::tile_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_resistance_order, 0).toInt() == i) {
-                resistance->setGridId(i);
-                dataList.append(resistance);
-            }
-
-            if (settings.value(QZSettings::tile_peloton_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_peloton_resistance_order, 0).toInt() == i) {
-                peloton_resistance->setGridId(i);
-                dataList.append(peloton_resistance);
-            }
-
-            if (settings.value(QZSettings::tile_watt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_watt_order, 0).toInt() == i) {
-                watt->setGridId(i);
-                dataList.append(watt);
-            }
+QList<TileLayoutEntry> homeform::tileLayoutEntries(bluetoothdevice::BLUETOOTH_TYPE type, bool pelotoncadence) {
+    if (type == bluetoothdevice::TREADMILL) {
+        return {
+            {QZSettings::tile_speed_enabled, true, QZSettings::tile_speed_order, 0, speed},
+            {QZSettings::tile_inclination_enabled, true, QZSettings::tile_inclination_order, 0, inclination},
+            {QZSettings::tile_elevation_enabled, true, QZSettings::tile_elevation_order, 0, elevation},
+            {QZSettings::tile_elapsed_enabled, true, QZSettings::tile_elapsed_order, 0, elapsed},
+            {QZSettings::tile_moving_time_enabled, false, QZSettings::tile_moving_time_order, 19, moving_time},
+            {QZSettings::tile_peloton_offset_enabled, false, QZSettings::tile_peloton_offset_order, 20, peloton_offset},
+            {QZSettings::tile_peloton_remaining_enabled, false, QZSettings::tile_peloton_remaining_order, 20,
+             peloton_remaining},
+            {QZSettings::tile_calories_enabled, true, QZSettings::tile_calories_order, 0, calories},
+            {QZSettings::tile_odometer_enabled, true, QZSettings::tile_odometer_order, 0, odometer},
+            {QZSettings::tile_pace_enabled, true, QZSettings::tile_pace_order, 0, pace},
+            {QZSettings::tile_watt_enabled, true, QZSettings::tile_watt_order, 0, watt},
+            {QZSettings::tile_weight_loss_enabled, false, QZSettings::tile_weight_loss_order, 24, weightLoss},
+            {QZSettings::tile_avgwatt_enabled, true, QZSettings::tile_avgwatt_order, 0, avgWatt},
+            {QZSettings::tile_ftp_enabled, true, QZSettings::tile_ftp_order, 0, ftp},
+            {QZSettings::tile_jouls_enabled, true, QZSettings::tile_jouls_order, 0, jouls},
+            {QZSettings::tile_heart_enabled, true, QZSettings::tile_heart_order, 0, heart},
+            {QZSettings::tile_fan_enabled, true, QZSettings::tile_fan_order, 0, fan},
+            {QZSettings::tile_datetime_enabled, true, QZSettings::tile_datetime_order, 0, datetime},
+            {QZSettings::tile_lapelapsed_enabled, false, QZSettings::tile_lapelapsed_order, 18, lapElapsed},
+            {QZSettings::tile_watt_kg_enabled, false, QZSettings::tile_watt_kg_order, 24, wattKg},
+            {QZSettings::tile_remainingtimetrainprogramrow_enabled, false,
+             QZSettings::tile_remainingtimetrainprogramrow_order, 27, remaningTimeTrainingProgramCurrentRow},
+            {QZSettings::tile_nextrowstrainprogram_enabled, false, QZSettings::tile_nextrowstrainprogram_order, 31,
+             nextRows},
+            {QZSettings::tile_mets_enabled, false, QZSettings::tile_mets_order, 28, mets},
+            {QZSettings::tile_targetmets_enabled, false, QZSettings::tile_targetmets_order, 29, targetMets},
+            {QZSettings::tile_target_speed_enabled, false, QZSettings::tile_target_speed_order, 28, target_speed},
+            {QZSettings::tile_target_incline_enabled, false, QZSettings::tile_target_incline_order, 29, target_incline},
+            {QZSettings::tile_cadence_enabled, false, QZSettings::tile_cadence_order, 30, cadence},
+            {QZSettings::tile_pid_hr_enabled, false, QZSettings::tile_pid_hr_order, 31, pidHR},
+            {QZSettings::tile_instantaneous_stride_length_enabled, false,
+             QZSettings::tile_instantaneous_stride_length_order, 32, instantaneousStrideLengthCM},
+            {QZSettings::tile_ground_contact_enabled, false, QZSettings::tile_ground_contact_order, 33,
+             groundContactMS},
+            {QZSettings::tile_vertical_oscillation_enabled, false, QZSettings::tile_vertical_oscillation_order, 34,
+             verticalOscillationMM},
+        };
+    } else if (type == bluetoothdevice::BIKE) {
+        // the proform studio is the only bike managed with an inclination properties.
+        // In order to don't break the tiles layout to all the bikes users, i enable this
+        // only if this bike is selected
+        // since i'm adding the inclination from zwift in this tile, in order to preserve the
+        // layour for legacy users, i'm not showing this one if the peloton cadence sensor setting
+        // is enabled (assuming that if someone has it, he doesn't want an inclination tile)
+        return {
+            {QZSettings::tile_speed_enabled, true, QZSettings::tile_speed_order, 0, speed},
+            {QZSettings::tile_cadence_enabled, true, QZSettings::tile_cadence_order, 0, cadence},
+            {QZSettings::tile_elevation_enabled, true, QZSettings::tile_elevation_order, 0, elevation},
+            {QZSettings::tile_elapsed_enabled, true, QZSettings::tile_elapsed_order, 0, elapsed},
+            {QZSettings::tile_moving_time_enabled, false, QZSettings::tile_moving_time_order, 19, moving_time},
+            {QZSettings::tile_peloton_offset_enabled, false, QZSettings::tile_peloton_offset_order, 20, peloton_offset},
+            {QZSettings::tile_peloton_remaining_enabled, false, QZSettings::tile_peloton_remaining_order, 20,
+             peloton_remaining},
+            {QZSettings::tile_calories_enabled, true, QZSettings::tile_calories_order, 0, calories},
+            {QZSettings::tile_odometer_enabled, true, QZSettings::tile_odometer_order, 0, odometer},
+            {QZSettings::tile_resistance_enabled, true, QZSettings::tile_resistance_order, 0, resistance},
+            {QZSettings::tile_peloton_resistance_enabled, true, QZSettings::tile_peloton_resistance_order, 0,
+             peloton_resistance},
+            {QZSettings::tile_watt_enabled, true, QZSettings::tile_watt_order, 0, watt},
+            {QZSettings::tile_weight_loss_enabled, false, QZSettings::tile_weight_loss_order, 24, weightLoss},
+            {QZSettings::tile_avgwatt_enabled, true, QZSettings::tile_avgwatt_order, 0, avgWatt},
+            {QZSettings::tile_ftp_enabled, true, QZSettings::tile_ftp_order, 0, ftp},
+            {QZSettings::tile_jouls_enabled, true, QZSettings::tile_jouls_order, 0, jouls},
+            {QZSettings::tile_heart_enabled, true, QZSettings::tile_heart_order, 0, heart},
+            {QZSettings::tile_fan_enabled, true, QZSettings::tile_fan_order, 0, fan},
+            {QZSettings::tile_datetime_enabled, true, QZSettings::tile_datetime_order, 0, datetime},
+            {QZSettings::tile_target_resistance_enabled, true, QZSettings::tile_target_resistance_order, 0,
+             target_resistance},
+            {QZSettings::tile_target_peloton_resistance_enabled, false,
+             QZSettings::tile_target_peloton_resistance_order, 21, target_peloton_resistance},
+            {QZSettings::tile_target_cadence_enabled, false, QZSettings::tile_target_cadence_order, 19, target_cadence},
+            {QZSettings::tile_target_power_enabled, false, QZSettings::tile_target_power_order, 20, target_power},
+            {QZSettings::tile_target_zone_enabled, false, QZSettings::tile_target_zone_order, 24, target_zone},
+            {QZSettings::tile_lapelapsed_enabled, false, QZSettings::tile_lapelapsed_order, 18, lapElapsed},
+            {QZSettings::tile_watt_kg_enabled, false, QZSettings::tile_watt_kg_order, 24, wattKg},
+            {QZSettings::tile_gears_enabled, false, QZSettings::tile_gears_order, 25, gears},
+            {QZSettings::tile_remainingtimetrainprogramrow_enabled, false,
+             QZSettings::tile_remainingtimetrainprogramrow_order, 27, remaningTimeTrainingProgramCurrentRow},
+            {QZSettings::tile_nextrowstrainprogram_enabled, false, QZSettings::tile_nextrowstrainprogram_order, 31,
+             nextRows},
+            {QZSettings::tile_mets_enabled, false, QZSettings::tile_mets_order, 28, mets},
+            {QZSettings::tile_targetmets_enabled, false, QZSettings::tile_targetmets_order, 29, targetMets},
+            {QZSettings::tile_inclination_enabled, true, QZSettings::tile_inclination_order, 29, inclination,
+             !pelotoncadence},
+            {QZSettings::tile_steering_angle_enabled, false, QZSettings::tile_steering_angle_order, 30, steeringAngle},
+            {QZSettings::tile_pid_hr_enabled, false, QZSettings::tile_pid_hr_order, 31, pidHR},
+            {QZSettings::tile_ext_incline_enabled, false, QZSettings::tile_ext_incline_order, 32, extIncline},
+        };
+    } else if (type == bluetoothdevice::ROWING) {
+        return {
+            {QZSettings::tile_speed_enabled, true, QZSettings::tile_speed_order, 0, speed},
+            {QZSettings::tile_cadence_enabled, true, QZSettings::tile_cadence_order, 0, cadence},
+            {QZSettings::tile_elevation_enabled, true, QZSettings::tile_elevation_order, 0, elevation},
+            {QZSettings::tile_elapsed_enabled, true, QZSettings::tile_elapsed_order, 0, elapsed},
+            {QZSettings::tile_moving_time_enabled, false, QZSettings::tile_moving_time_order, 19, moving_time},
+            {QZSettings::tile_peloton_offset_enabled, false, QZSettings::tile_peloton_offset_order, 20, peloton_offset},
+            {QZSettings::tile_peloton_remaining_enabled, false, QZSettings::tile_peloton_remaining_order, 20,
+             peloton_remaining},
+            {QZSettings::tile_calories_enabled, true, QZSettings::tile_calories_order, 0, calories},
+            {QZSettings::tile_odometer_enabled, true, QZSettings::tile_odometer_order, 0, odometer},
+            {QZSettings::tile_resistance_enabled, true, QZSettings::tile_resistance_order, 0, resistance},
+            {QZSettings::tile_peloton_resistance_enabled, true, QZSettings::tile_peloton_resistance_order, 0,
+             peloton_resistance},
+            {QZSettings::tile_watt_enabled, true, QZSettings::tile_watt_order, 0, watt},
+            {QZSettings::tile_weight_loss_enabled, false, QZSettings::tile_weight_loss_order, 24, weightLoss},
+            {QZSettings::tile_avgwatt_enabled, true, QZSettings::tile_avgwatt_order, 0, avgWatt},
+            {QZSettings::tile_ftp_enabled, true, QZSettings::tile_ftp_order, 0, ftp},
+            {QZSettings::tile_jouls_enabled, true, QZSettings::tile_jouls_order, 0, jouls},
+            {QZSettings::tile_heart_enabled, true, QZSettings::tile_heart_order, 0, heart},
+            {QZSettings::tile_fan_enabled, true, QZSettings::tile_fan_order, 0, fan},
+            {QZSettings::tile_datetime_enabled, true, QZSettings::tile_datetime_order, 0, datetime},
+            {QZSettings::tile_target_resistance_enabled, true, QZSettings::tile_target_resistance_order, 0,
+             target_resistance},
+            {QZSettings::tile_target_peloton_resistance_enabled, false,
+             QZSettings::tile_target_peloton_resistance_order, 21, target_peloton_resistance},
+            {QZSettings::tile_target_cadence_enabled, false, QZSettings::tile_target_cadence_order, 19, target_cadence},
+            {QZSettings::tile_target_power_enabled, false, QZSettings::tile_target_power_order, 20, target_power},
+            {QZSettings::tile_lapelapsed_enabled, false, QZSettings::tile_lapelapsed_order, 18, lapElapsed},
+            {QZSettings::tile_strokes_length_enabled, false, QZSettings::tile_strokes_length_order, 21, strokesLength},
+            {QZSettings::tile_strokes_count_enabled, false, QZSettings::tile_strokes_count_order, 22, strokesCount},
+            {QZSettings::tile_pace_enabled, true, QZSettings::tile_pace_order, 0, pace},
+            {QZSettings::tile_watt_kg_enabled, false, QZSettings::tile_watt_kg_order, 24, wattKg},
+            {QZSettings::tile_remainingtimetrainprogramrow_enabled, false,
+             QZSettings::tile_remainingtimetrainprogramrow_order, 27, remaningTimeTrainingProgramCurrentRow},
+            {QZSettings::tile_nextrowstrainprogram_enabled, false, QZSettings::tile_nextrowstrainprogram_order, 31,
+             nextRows},
+            {QZSettings::tile_mets_enabled, false, QZSettings::tile_mets_order, 28, mets},
+            {QZSettings::tile_targetmets_enabled, false, QZSettings::tile_targetmets_order, 29, targetMets},
+            {QZSettings::tile_pid_hr_enabled, false, QZSettings::tile_pid_hr_order, 31, pidHR},
+            {QZSettings::tile_target_zone_enabled, false, QZSettings::tile_target_zone_order, 24, target_zone},
+        };
+    } else if (type == bluetoothdevice::ELLIPTICAL) {
+        return {
+            {QZSettings::tile_speed_enabled, true, QZSettings::tile_speed_order, 0, speed},
+            {QZSettings::tile_cadence_enabled, true, QZSettings::tile_cadence_order, 0, cadence},
+            {QZSettings::tile_inclination_enabled, true, QZSettings::tile_inclination_order, 0, inclination},
+            {QZSettings::tile_elevation_enabled, true, QZSettings::tile_elevation_order, 0, elevation},
+            {QZSettings::tile_elapsed_enabled, true, QZSettings::tile_elapsed_order, 0, elapsed},
+            {QZSettings::tile_moving_time_enabled, false, QZSettings::tile_moving_time_order, 19, moving_time},
+            {QZSettings::tile_peloton_offset_enabled, false, QZSettings::tile_peloton_offset_order, 20, peloton_offset},
+            {QZSettings::tile_peloton_remaining_enabled, false, QZSettings::tile_peloton_remaining_order, 20,
+             peloton_remaining},
+            {QZSettings::tile_calories_enabled, true, QZSettings::tile_calories_order, 0, calories},
+            {QZSettings::tile_odometer_enabled, true, QZSettings::tile_odometer_order, 0, odometer},
+            {QZSettings::tile_resistance_enabled, true, QZSettings::tile_resistance_order, 0, resistance},
+            {QZSettings::tile_peloton_resistance_enabled, true, QZSettings::tile_peloton_resistance_order, 0,
+             peloton_resistance},
+            {QZSettings::tile_watt_enabled, true, QZSettings::tile_watt_order, 0, watt},
+            {QZSettings::tile_weight_loss_enabled, false, QZSettings::tile_weight_loss_order, 24, weightLoss},
+            {QZSettings::tile_avgwatt_enabled, true, QZSettings::tile_avgwatt_order, 0, avgWatt},
+            {QZSettings::tile_ftp_enabled, true, QZSettings::tile_ftp_order, 0, ftp},
+            {QZSettings::tile_jouls_enabled, true, QZSettings::tile_jouls_order, 0, jouls},
+            {QZSettings::tile_heart_enabled, true, QZSettings::tile_heart_order, 0, heart},
+            {QZSettings::tile_fan_enabled, true, QZSettings::tile_fan_order, 0, fan},
+            {QZSettings::tile_datetime_enabled, true, QZSettings::tile_datetime_order, 0, datetime},
+            {QZSettings::tile_target_resistance_enabled, true, QZSettings::tile_target_resistance_order, 0,
+             target_resistance},
+            {QZSettings::tile_lapelapsed_enabled, false, QZSettings::tile_lapelapsed_order, 18, lapElapsed},
+            {QZSettings::tile_watt_kg_enabled, false, QZSettings::tile_watt_kg_order, 24, wattKg},
+            {QZSettings::tile_remainingtimetrainprogramrow_enabled, false,
+             QZSettings::tile_remainingtimetrainprogramrow_order, 27, remaningTimeTrainingProgramCurrentRow},
+            {QZSettings::tile_nextrowstrainprogram_enabled, false, QZSettings::tile_nextrowstrainprogram_order, 31,
+             nextRows},
+            {QZSettings::tile_mets_enabled, false, QZSettings::tile_mets_order, 28, mets},
+            {QZSettings::tile_targetmets_enabled, false, QZSettings::tile_targetmets_order, 29, targetMets},
+            {QZSettings::tile_pid_hr_enabled, false, QZSettings::tile_pid_hr_order, 31, pidHR},
+            {QZSettings::tile_target_cadence_enabled, false, QZSettings::tile_target_cadence_order, 19, target_cadence},
+            {QZSettings::tile_target_speed_enabled, false, QZSettings::tile_target_speed_order, 28, target_speed},
+        };
+    }
+    return {};
+}
 
-            if (settings.value(QZSettings::tile_weight_loss_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_weight_loss_order, 24).toInt() == i) {
-                weightLoss->setGridId(i);
-                dataList.append(weightLoss);
-            }
+void homeform::invalidateTileLayout() { tileLayoutValid = false; }
 
-            if (settings.value(QZSettings::tile_avgwatt_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_avgwatt_order, 0).toInt() == i) {
-                avgWatt->setGridId(i);
-                dataList.append(avgWatt);
-            }
+void homeform::settingsChanged() {
+    loadUpdateSettings();
 
-            if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
-                ftp->setGridId(i);
-                dataList.append(ftp);
-            }
-
-            if (settings.value(QZSettings::tile_jouls_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_jouls_order, 0).toInt() == i) {
-                jouls->setGridId(i);
-                dataList.append(jouls);
-            }
-
-            if (settings.value(QZSettings::tile_heart_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_heart_order, 0).toInt() == i) {
-                heart->setGridId(i);
-                dataList.append(heart);
-            }
+    QList<QPair<int, DataObject *>> oldLayout = tileLayout;
+    invalidateTileLayout();
+    // the grid is rebuilt only when the tiles really changed
+    if (bluetoothManager && bluetoothManager->device()) {
+        buildTileLayout(bluetoothManager->device()->deviceType());
+        if (tileLayout != oldLayout)
+            sortTiles();
+    }
+}
 
-            if (settings.value(QZSettings::tile_fan_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_fan_order, 0).toInt() == i) {
-                fan->setGridId(i);
-                dataList.append(fan);
-            }
+void homeform::loadUpdateSettings() {
+    QSettings settings;
+    if (settings.status() != QSettings::NoError) {
+        qDebug() << "!!!!QSETTINGS ERROR!" << settings.status();
+    }
 
-            if (settings.value(QZSettings::tile_datetime_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_datetime_order, 0).toInt() == i) {
-                datetime->setGridId(i);
-                dataList.append(datetime);
-            }
+    updateSettings.topBarEnabled =
+        settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool();
+    updateSettings.miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
+    updateSettings.ftp = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+    updateSettings.power5s = settings.value(QZSettings::power_avg_5s, QZSettings::default_power_avg_5s).toBool();
+    // "Disabled" converts to 0
+    updateSettings.pidHeartZone =
+        settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
+            .toString()
+            .toUInt();
+    updateSettings.fanfitEnabled =
+        settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool();
+    updateSettings.fanfitMode =
+        settings.value(QZSettings::fitmetria_fanfit_mode, QZSettings::default_fitmetria_fanfit_mode).toString();
+    updateSettings.pelotonCadence =
+        settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
+    updateSettings.eliteRizerGain =
+        settings.value(QZSettings::elite_rizer_gain, QZSettings::default_elite_rizer_gain).toDouble();
+    updateSettings.resistanceGain =
+        settings.value(QZSettings::bike_resistance_gain_f, QZSettings::default_bike_resistance_gain_f).toDouble();
+    updateSettings.resistanceOffset =
+        settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset).toDouble();
+    updateSettings.pelotonResistanceColor = settings
+                                                .value(QZSettings::tile_peloton_resistance_color_enabled,
+                                                       QZSettings::default_tile_peloton_resistance_color_enabled)
+                                                .toBool();
+    updateSettings.cadenceColor =
+        settings.value(QZSettings::tile_cadence_color_enabled, QZSettings::default_tile_cadence_color_enabled)
+            .toBool();
+    updateSettings.heartRateZone[0] =
+        settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble();
+    updateSettings.heartRateZone[1] =
+        settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble();
+    updateSettings.heartRateZone[2] =
+        settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble();
+    updateSettings.heartRateZone[3] =
+        settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble();
+    updateSettings.heartRateMax = heartRateMax();
+    updateSettings.pidSampleTime =
+        settings.value(QZSettings::hr_zone_pid_sample_time, QZSettings::default_hr_zone_pid_sample_time).toUInt();
+    updateSettings.pidActuator =
+        settings.value(QZSettings::hr_zone_pid_actuator, QZSettings::default_hr_zone_pid_actuator).toString();
+    updateSettings.pidKp = settings.value(QZSettings::hr_zone_pid_kp, QZSettings::default_hr_zone_pid_kp).toDouble();
+    updateSettings.pidKi = settings.value(QZSettings::hr_zone_pid_ki, QZSettings::default_hr_zone_pid_ki).toDouble();
+    updateSettings.pidKd = settings.value(QZSettings::hr_zone_pid_kd, QZSettings::default_hr_zone_pid_kd).toDouble();
+    updateSettings.trainProgramRandom =
+        settings.value(QZSettings::trainprogram_random, QZSettings::default_trainprogram_random).toBool();
+    updateSettings.antCadence = settings.value(QZSettings::ant_cadence, QZSettings::default_ant_cadence).toBool();
+    updateSettings.ttsEnabled = settings.value(QZSettings::tts_enabled, QZSettings::default_tts_enabled).toBool();
+    updateSettings.ttsDescription =
+        settings.value(QZSettings::tts_description_enabled, QZSettings::default_tts_description_enabled).toBool();
+    updateSettings.ttsSummarySec =
+        settings.value(QZSettings::tts_summary_sec, QZSettings::default_tts_summary_sec).toInt();
+}
 
-            if (settings.value(QZSettings::tile_target_resistance_enabled, true).toBool() &&
-                settings.value(QZSettings::tile_target_resistance_order, 0).toInt() == i) {
-                target_resistance->setGridId(i);
-                dataList.append(target_resistance);
-            }
+void homeform::watchSettings(QObject *qmlSettings) {
+    if (!qmlSettings)
+        return;
+    QMetaMethod start = QTimer::staticMetaObject.method(QTimer::staticMetaObject.indexOfSlot("start()"));
+    const QMetaObject *mo = qmlSettings->metaObject();
+    for (int i = 0; i < mo->propertyCount(); i++) {
+        QMetaProperty p = mo->property(i);
+        if (p.hasNotifySignal())
+            connect(qmlSettings, p.notifySignal(), &settingsChangedTimer, start, Qt::UniqueConnection);
+    }
+}
 
-            if (settings.value(QZSettings::tile_lapelapsed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_lapelapsed_order, 18).toInt() == i) {
-                lapElapsed->setGridId(i);
-                dataList.append(lapElapsed);
-            }
+void homeform::sortTiles() {
 
-            if (settings.value(QZSettings::tile_watt_kg_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_watt_kg_order, 24).toInt() == i) {
-                wattKg->setGridId(i);
-                dataList.append(wattKg);
-            }
+    if (!bluetoothManager || !bluetoothManager->device())
+        return;
 
-            if (settings.value(QZSettings::tile_remainingtimetrainprogramrow_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_remainingtimetrainprogramrow_order, 27).toInt() == i) {
-                remaningTimeTrainingProgramCurrentRow->setGridId(i);
-                dataList.append(remaningTimeTrainingProgramCurrentRow);
-            }
+    bluetoothdevice::BLUETOOTH_TYPE type = bluetoothManager->device()->deviceType();
+    buildTileLayout(type);
 
-            if (settings.value(QZSettings::tile_nextrowstrainprogram_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_nextrowstrainprogram_order, 31).toInt() == i) {
+    if (type == bluetoothdevice::ROWING) {
+        cadence->setName("Stroke Rate");
+        odometer->setName("Odometer (m)");
+        pace->setName("Pace (m/500m)");
+    }
 
-                nextRows->setGridId(i);
-                dataList.append(nextRows);
-            }
+    dataList.clear();
+    visibleTiles.clear();
+    for (const QPair<int, DataObject *> &t : qAsConst(tileLayout)) {
+        t.second->setGridId(t.first);
+        dataList.append(t.second);
+        visibleTiles.insert(t.second);
+    }
 
-            if (settings.value(QZSettings::tile_mets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_mets_order, 28).toInt() == i) {
-                mets->setGridId(i);
-                dataList.append(mets);
-            }
-            if (settings.value(QZSettings::tile_targetmets_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_targetmets_order, 29).toInt() == i) {
-                targetMets->setGridId(i);
-                dataList.append(targetMets);
-            }
+    engine->rootContext()->setContextProperty(QStringLiteral("appModel"), QVariant::fromValue(dataList));
+}
 
-            if (settings.value(QZSettings::tile_pid_hr_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_pid_hr_order, 31).toInt() == i) {
-                pidHR->setGridId(i);
-                dataList.append(pidHR);
-            }
+void homeform::buildTileLayout(bluetoothdevice::BLUETOOTH_TYPE type) {
+    if (!tileLayoutValid || tileLayoutType != type) {
+        // a single settings pass, the sorted layout is kept until a tile setting changes
+        QSettings settings;
+        bool pelotoncadence =
+            settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
 
-            if (settings.value(QZSettings::tile_target_cadence_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_cadence_order, 19).toInt() == i) {
-                target_cadence->setGridId(i);
-                dataList.append(target_cadence);
+        tileLayout.clear();
+        for (const TileLayoutEntry &e : tileLayoutEntries(type, pelotoncadence)) {
+            if (!e.available || !settings.value(e.enabledKey, e.enabledDefault).toBool()) {
+                continue;
             }
-
-            if (settings.value(QZSettings::tile_target_speed_enabled, false).toBool() &&
-                settings.value(QZSettings::tile_target_speed_order, 28).toInt() == i) {
-                target_speed->setGridId(i);
-                dataList.append(target_speed);
+            int order = settings.value(e.orderKey, e.orderDefault).toInt();
+            if (order >= 0 && order < 100) {
+                tileLayout.append(qMakePair(order, e.tile));
             }
         }
+        // stable, so tiles with the same order keep the declaration order
+        std::stable_sort(tileLayout.begin(), tileLayout.end(),
+                         [](const QPair<int, DataObject *> &a, const QPair<int, DataObject *> &b) {
+                             return a.first < b.first;
+                         });
+        tileLayoutType = type;
+        tileLayoutValid = true;
     }
-
-    engine->rootContext()->setContextProperty(QStringLiteral("appModel"), QVariant::fromValue(dataList));
 }
 
 DataObject *homeform::tileFromName(QString name) {
@@ -1593,12 +1132,128 @@ void homeform::moveTile(QString name, int newIndex, int oldIndex) {
         // sortTiles();
         // dataList.move(oldIndex, newIndex);
         // very dirty, but i needed a way to synchronize QML with C++
+        invalidateTileLayout();
         QTimer::singleShot(100, this, &homeform::sortTilesTimeout);
     }
 }
 
 void homeform::sortTilesTimeout() { sortTiles(); }
 
+void homeform::setupTileBindings() {
+    tileBindings = {
+        {speed, [](bluetoothdevice *d) { return d->currentSpeed(); }, 1, TileBinding::SPEED, TileBinding::AVG_MAX},
+        {heart, [](bluetoothdevice *d) { return d->currentHeart(); }, 0},
+        {calories, [](bluetoothdevice *d) { return d->calories(); }, 0, TileBinding::NONE,
+         TileBinding::RATE_PER_MINUTE},
+        {jouls, [](bluetoothdevice *d) { return d->jouls(); }, 1, TileBinding::NONE, TileBinding::RATE_PER_MINUTE,
+         0.001},
+        {mets, [](bluetoothdevice *d) { return d->currentMETS(); }, 1, TileBinding::NONE, TileBinding::AVG_MAX},
+        {avgWatt, [](bluetoothdevice *d) { return d->wattsMetric(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, true},
+        {wattKg, [](bluetoothdevice *d) { return d->wattKg(); }, 1, TileBinding::NONE, TileBinding::AVG_MAX},
+        {inclination, [](bluetoothdevice *d) { return d->currentInclination(); }, 1, TileBinding::NONE,
+         TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::TREADMILL},
+        {inclination, [](bluetoothdevice *d) { return d->currentInclination(); }, 1, TileBinding::NONE,
+         TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::ELLIPTICAL},
+        {instantaneousStrideLengthCM, [](bluetoothdevice *d) { return ((treadmill *)d)->currentStrideLength(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::TREADMILL},
+        {groundContactMS, [](bluetoothdevice *d) { return ((treadmill *)d)->currentGroundContact(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::TREADMILL},
+        {verticalOscillationMM, [](bluetoothdevice *d) { return ((treadmill *)d)->currentVerticalOscillation(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::TREADMILL},
+        {target_speed, [](bluetoothdevice *d) { return ((treadmill *)d)->lastRequestedSpeed(); }, 1,
+         TileBinding::SPEED, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::TREADMILL},
+        {target_incline, [](bluetoothdevice *d) { return ((treadmill *)d)->lastRequestedInclination(); }, 1,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::TREADMILL},
+        {cadence, [](bluetoothdevice *d) { return d->currentCadence(); }, 0, TileBinding::NONE, TileBinding::AVG_MAX},
+
+        {resistance, [](bluetoothdevice *d) { return ((bike *)d)->currentResistance(); }, 0, TileBinding::NONE,
+         TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::BIKE},
+        {peloton_resistance, [](bluetoothdevice *d) { return ((bike *)d)->pelotonResistance(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::BIKE},
+        {target_resistance, [](bluetoothdevice *d) { return ((bike *)d)->lastRequestedResistance(); }, 0,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::BIKE},
+        {target_peloton_resistance, [](bluetoothdevice *d) { return ((bike *)d)->lastRequestedPelotonResistance(); },
+         0, TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::BIKE},
+        {target_cadence, [](bluetoothdevice *d) { return ((bike *)d)->lastRequestedCadence(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::BIKE},
+        {target_power, [](bluetoothdevice *d) { return ((bike *)d)->lastRequestedPower(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::BIKE},
+        {steeringAngle, [](bluetoothdevice *d) { return ((bike *)d)->currentSteeringAngle(); }, 1, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::BIKE},
+
+        {resistance, [](bluetoothdevice *d) { return ((rower *)d)->currentResistance(); }, 0, TileBinding::NONE,
+         TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::ROWING},
+        {peloton_resistance, [](bluetoothdevice *d) { return ((rower *)d)->pelotonResistance(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::ROWING},
+        {target_resistance, [](bluetoothdevice *d) { return ((rower *)d)->lastRequestedResistance(); }, 0,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ROWING},
+        {target_peloton_resistance, [](bluetoothdevice *d) { return ((rower *)d)->lastRequestedPelotonResistance(); },
+         0, TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ROWING},
+        {target_cadence, [](bluetoothdevice *d) { return ((rower *)d)->lastRequestedCadence(); }, 0,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ROWING},
+        {target_power, [](bluetoothdevice *d) { return ((rower *)d)->lastRequestedPower(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ROWING},
+        {strokesCount, [](bluetoothdevice *d) { return ((rower *)d)->currentStrokesCount(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ROWING},
+        {strokesLength, [](bluetoothdevice *d) { return ((rower *)d)->currentStrokesLength(); }, 1,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::ROWING},
+
+        {peloton_resistance, [](bluetoothdevice *d) { return ((elliptical *)d)->pelotonResistance(); }, 0,
+         TileBinding::NONE, TileBinding::AVG_MAX, 1.0, false, bluetoothdevice::ELLIPTICAL},
+        {target_resistance, [](bluetoothdevice *d) { return ((elliptical *)d)->lastRequestedResistance(); }, 0,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ELLIPTICAL},
+        {target_peloton_resistance,
+         [](bluetoothdevice *d) { return ((elliptical *)d)->lastRequestedPelotonResistance(); }, 0, TileBinding::NONE,
+         TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ELLIPTICAL},
+        {target_cadence, [](bluetoothdevice *d) { return ((elliptical *)d)->lastRequestedCadence(); }, 0,
+         TileBinding::NONE, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ELLIPTICAL},
+        {target_speed, [](bluetoothdevice *d) { return ((elliptical *)d)->lastRequestedSpeed(); }, 1,
+         TileBinding::SPEED, TileBinding::NO_SECOND_LINE, 1.0, false, bluetoothdevice::ELLIPTICAL},
+    };
+}
+
+int homeform::benchmarkUpdate(int refreshes) {
+    int notifications = 0;
+    QList<QMetaObject::Connection> counters;
+    for (QObject *o : qAsConst(dataList)) {
+        counters.append(connect((DataObject *)o, &DataObject::valueChanged, this, [&]() { notifications++; }));
+        counters.append(connect((DataObject *)o, &DataObject::secondLineChanged, this, [&]() { notifications++; }));
+    }
+    for (int i = 0; i < refreshes; i++)
+        update();
+    for (const QMetaObject::Connection &c : qAsConst(counters))
+        disconnect(c);
+    return notifications;
+}
+
+void homeform::updateTileBindings(bool miles) {
+    bluetoothdevice *dev = bluetoothManager->device();
+    for (const TileBinding &b : qAsConst(tileBindings)) {
+        if (!visibleTiles.contains(b.tile) ||
+            (b.deviceType != bluetoothdevice::UNKNOWN && b.deviceType != dev->deviceType())) {
+            continue;
+        }
+        b.update(dev, miles);
+    }
+}
+
+void TileBinding::update(bluetoothdevice *dev, bool miles) const {
+    double conversion = scale;
+    if (miles && unit == SPEED) {
+        conversion *= 0.621371;
+    }
+
+    metric m = accessor(dev);
+    tile->setValue(QString::number((average ? m.average() : m.value()) * conversion, 'f', decimals));
+    if (secondLine == AVG_MAX) {
+        tile->setSecondLine(QStringLiteral("AVG: ") + QString::number(m.average() * conversion, 'f', decimals) +
+                            QStringLiteral(" MAX: ") + QString::number(m.max() * conversion, 'f', decimals));
+    } else if (secondLine == RATE_PER_MINUTE) {
+        tile->setSecondLine(QString::number(m.rate1s() * conversion * 60.0, 'f', 1) + " /min");
+    }
+}
+
 void homeform::deviceConnected(QBluetoothDeviceInfo b) {
 
     qDebug() << "deviceConnected" << bluetoothManager << engine;
@@ -1700,6 +1355,7 @@ void homeform::Plus(const QString &name) {
             settings.value(QZSettings::elite_rizer_gain, QZSettings::default_elite_rizer_gain).toDouble();
         elite_rizer_gain = elite_rizer_gain + 0.1;
         settings.setValue(QZSettings::elite_rizer_gain, elite_rizer_gain);
+        updateSettings.eliteRizerGain = elite_rizer_gain;
     } else if (name.contains(QStringLiteral("inclination"))) {
         if (bluetoothManager->device()) {
             if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -1736,6 +1392,7 @@ void homeform::Plus(const QString &name) {
             if (zone < 5) {
                 zone++;
                 settings.setValue(QZSettings::treadmill_pid_heart_zone, QString::number(zone));
+                updateSettings.pidHeartZone = zone;
             }
         }
     } else if (name.contains("gears")) {
@@ -1851,6 +1508,7 @@ void homeform::Minus(const QString &name) {
         if (elite_rizer_gain)
             elite_rizer_gain = elite_rizer_gain - 0.1;
         settings.setValue(QZSettings::elite_rizer_gain, elite_rizer_gain);
+        updateSettings.eliteRizerGain = elite_rizer_gain;
     } else if (name.contains(QStringLiteral("inclination"))) {
         if (bluetoothManager->device()) {
             if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -1880,8 +1538,10 @@ void homeform::Minus(const QString &name) {
             if (zone > 1) {
                 zone--;
                 settings.setValue(QZSettings::treadmill_pid_heart_zone, QString::number(zone));
+                updateSettings.pidHeartZone = zone;
             } else {
                 settings.setValue(QZSettings::treadmill_pid_heart_zone, QStringLiteral("Disabled"));
+                updateSettings.pidHeartZone = 0;
             }
         }
     } else if (name.contains(QStringLiteral("gears"))) {
@@ -1989,6 +1649,8 @@ void homeform::Start_inner(bool send_event_to_device) {
                 bluetoothManager->device()->clearStats();
             }
             Session.clear();
+            chartModel->clear();
+            pathController.clearRidden();
             chartImagesFilenames.clear();
 
             if (!pelotonHandler || (pelotonHandler && !pelotonHandler->isWorkoutInProgress())) {
@@ -2148,16 +1810,12 @@ QString homeform::signal() {
 
 void homeform::update() {
 
-    QSettings settings;
     double currentHRZone = 1;
     double ftpZone = 1;
 
-    if (settings.status() != QSettings::NoError) {
-        qDebug() << "!!!!QSETTINGS ERROR!" << settings.status();
-    }
-
-    if ((paused || stopped) &&
-        settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool()) {
+    // the settings come from updateSettings and the tiles that aren't shown are not formatted: the tiles fed by a
+    // single metric are in tileBindings, the others are guarded by tileVisible() below
+    if ((paused || stopped) && updateSettings.topBarEnabled) {
 
         emit stopIconChanged(stopIcon());
         emit stopTextChanged(stopText());
@@ -2172,31 +1830,15 @@ void homeform::update() {
         double inclination = 0;
         double resistance = 0;
         double watts = 0;
-        double pace = 0;
         double peloton_resistance = 0;
         uint8_t cadence = 0;
-        uint32_t totalStrokes = 0;
-        double avgStrokesRate = 0;
-        double maxStrokesRate = 0;
-        double avgStrokesLength = 0;
-        double strideLength = 0;
-        double groundContact = 0;
-        double verticalOscillation = 0;
-
-        bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
-        double ftpSetting = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+
+        bool miles = updateSettings.miles;
+        double ftpSetting = updateSettings.ftp;
         double unit_conversion = 1.0;
         double meter_feet_conversion = 1.0;
-        bool power5s = settings.value(QZSettings::power_avg_5s, QZSettings::default_power_avg_5s).toBool();
-        uint8_t treadmill_pid_heart_zone =
-            settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
-                .toString()
-                .toUInt();
-        QString treadmill_pid_heart_zone_string =
-            settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
-                .toString();
-        if (!treadmill_pid_heart_zone_string.compare(QStringLiteral("Disabled")))
-            treadmill_pid_heart_zone = 0;
+        bool power5s = updateSettings.power5s;
+        uint8_t treadmill_pid_heart_zone = updateSettings.pidHeartZone;
 
         if (miles) {
             unit_conversion = 0.621371;
@@ -2205,40 +1847,41 @@ void homeform::update() {
 
         emit signalChanged(signal());
         emit currentSpeedChanged(bluetoothManager->device()->currentSpeed().value());
-        speed->setValue(QString::number(bluetoothManager->device()->currentSpeed().value() * unit_conversion, 'f', 1));
-        speed->setSecondLine(
-            QStringLiteral("AVG: ") +
-            QString::number((bluetoothManager->device())->currentSpeed().average() * unit_conversion, 'f', 1) +
-            QStringLiteral(" MAX: ") +
-            QString::number((bluetoothManager->device())->currentSpeed().max() * unit_conversion, 'f', 1));
-        heart->setValue(QString::number(bluetoothManager->device()->currentHeart().value(), 'f', 0));
-
-        calories->setValue(QString::number(bluetoothManager->device()->calories().value(), 'f', 0));
-        calories->setSecondLine(QString::number(bluetoothManager->device()->calories().rate1s() * 60.0, 'f', 1) +
-                                " /min");
-        if (!settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool())
-            fan->setValue(QString::number(bluetoothManager->device()->fanSpeed()));
-        else
-            fan->setValue(QString::number(qRound(((double)bluetoothManager->device()->fanSpeed()) / 10.0) * 10.0));
-        jouls->setValue(QString::number(bluetoothManager->device()->jouls().value() / 1000.0, 'f', 1));
-        jouls->setSecondLine(QString::number(bluetoothManager->device()->jouls().rate1s() / 1000.0 * 60.0, 'f', 1) +
-                             " /min");
-        elapsed->setValue(bluetoothManager->device()->elapsedTime().toString(QStringLiteral("h:mm:ss")));
-        moving_time->setValue(bluetoothManager->device()->movingTime().toString(QStringLiteral("h:mm:ss")));
-        pidHR->setValue(QString::number(treadmill_pid_heart_zone));
+        updateTileBindings(miles);
+
+        if (tileVisible(fan)) {
+            if (!updateSettings.fanfitEnabled)
+                fan->setValue(QString::number(bluetoothManager->device()->fanSpeed()));
+            else
+                fan->setValue(QString::number(qRound(((double)bluetoothManager->device()->fanSpeed()) / 10.0) * 10.0));
+        }
+        if (tileVisible(elapsed))
+            elapsed->setValue(bluetoothManager->device()->elapsedTime().toString(QStringLiteral("h:mm:ss")));
+        if (tileVisible(moving_time))
+            moving_time->setValue(bluetoothManager->device()->movingTime().toString(QStringLiteral("h:mm:ss")));
+        if (tileVisible(pidHR))
+            pidHR->setValue(QString::number(treadmill_pid_heart_zone));
 
         if (trainProgram) {
-            peloton_offset->setValue(QString::number(trainProgram->offsetElapsedTime()) + QStringLiteral(" sec."));
-            peloton_remaining->setValue(trainProgram->remainingTime().toString("h:mm:ss"));
-            peloton_remaining->setSecondLine(QString::number(trainProgram->offsetElapsedTime()) +
-                                             QStringLiteral(" sec."));
-            remaningTimeTrainingProgramCurrentRow->setValue(
-                trainProgram->currentRowRemainingTime().toString(QStringLiteral("h:mm:ss")));
-            remaningTimeTrainingProgramCurrentRow->setSecondLine(
-                trainProgram->currentRowElapsedTime().toString(QStringLiteral("h:mm:ss")));
-            targetMets->setValue(QString::number(trainProgram->currentTargetMets(), 'f', 1));
-            trainrow next = trainProgram->getRowFromCurrent(1);
-            trainrow next_1 = trainProgram->getRowFromCurrent(2);
+            if (tileVisible(peloton_offset))
+                peloton_offset->setValue(QString::number(trainProgram->offsetElapsedTime()) + QStringLiteral(" sec."));
+            if (tileVisible(peloton_remaining)) {
+                peloton_remaining->setValue(trainProgram->remainingTime().toString("h:mm:ss"));
+                peloton_remaining->setSecondLine(QString::number(trainProgram->offsetElapsedTime()) +
+                                                 QStringLiteral(" sec."));
+            }
+            if (tileVisible(remaningTimeTrainingProgramCurrentRow)) {
+                remaningTimeTrainingProgramCurrentRow->setValue(
+                    trainProgram->currentRowRemainingTime().toString(QStringLiteral("h:mm:ss")));
+                remaningTimeTrainingProgramCurrentRow->setSecondLine(
+                    trainProgram->currentRowElapsedTime().toString(QStringLiteral("h:mm:ss")));
+            }
+            if (tileVisible(targetMets))
+                targetMets->setValue(QString::number(trainProgram->currentTargetMets(), 'f', 1));
+        }
+        if (trainProgram && tileVisible(nextRows)) {
+            const trainrow &next = trainProgram->getRowFromCurrent(1);
+            const trainrow &next_1 = trainProgram->getRowFromCurrent(2);
             if (next.duration.second() != 0 || next.duration.minute() != 0 || next.duration.hour() != 0) {
                 if (next.requested_peloton_resistance != -1)
                     nextRows->setValue(QStringLiteral("PR") + QString::number(next.requested_peloton_resistance) +
@@ -2247,23 +1890,7 @@ void homeform::update() {
                     nextRows->setValue(QStringLiteral("R") + QString::number(next.resistance) + QStringLiteral(" ") +
                                        next.duration.toString(QStringLiteral("mm:ss")));
                 else if (next.power != -1) {
-                    double ftpPerc = (next.power / ftpSetting) * 100.0;
-                    uint8_t ftpZone = 1;
-                    if (ftpPerc < 56) {
-                        ftpZone = 1;
-                    } else if (ftpPerc < 76) {
-                        ftpZone = 2;
-                    } else if (ftpPerc < 91) {
-                        ftpZone = 3;
-                    } else if (ftpPerc < 106) {
-                        ftpZone = 4;
-                    } else if (ftpPerc < 121) {
-                        ftpZone = 5;
-                    } else if (ftpPerc < 151) {
-                        ftpZone = 6;
-                    } else {
-                        ftpZone = 7;
-                    }
+                    uint8_t ftpZone = trainProgram->zoneFromCurrent(1);
                     nextRows->setValue(QStringLiteral("Z") + QString::number(ftpZone) + QStringLiteral(" ") +
                                        next.duration.toString(QStringLiteral("mm:ss")));
                     if (next_1.duration.second() != 0 || next_1.duration.minute() != 0 || next_1.duration.hour() != 0) {
@@ -2276,23 +1903,7 @@ void homeform::update() {
                                                     QStringLiteral(" ") +
                                                     next_1.duration.toString(QStringLiteral("mm:ss")));
                         else if (next_1.power != -1) {
-                            double ftpPerc = (next_1.power / ftpSetting) * 100.0;
-                            uint8_t ftpZone = 1;
-                            if (ftpPerc < 56) {
-                                ftpZone = 1;
-                            } else if (ftpPerc < 76) {
-                                ftpZone = 2;
-                            } else if (ftpPerc < 91) {
-                                ftpZone = 3;
-                            } else if (ftpPerc < 106) {
-                                ftpZone = 4;
-                            } else if (ftpPerc < 121) {
-                                ftpZone = 5;
-                            } else if (ftpPerc < 151) {
-                                ftpZone = 6;
-                            } else {
-                                ftpZone = 7;
-                            }
+                            uint8_t ftpZone = trainProgram->zoneFromCurrent(2);
                             nextRows->setSecondLine(QStringLiteral("Z") + QString::number(ftpZone) +
                                                     QStringLiteral(" ") +
                                                     next_1.duration.toString(QStringLiteral("mm:ss")));
@@ -2305,36 +1916,26 @@ void homeform::update() {
                 nextRows->setValue(QStringLiteral("N/A"));
             }
         }
-        mets->setValue(QString::number(bluetoothManager->device()->currentMETS().value(), 'f', 1));
-        mets->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->currentMETS().average(), 'f', 1) +
-            QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->currentMETS().max(), 'f', 1));
-        lapElapsed->setValue(bluetoothManager->device()->lapElapsedTime().toString(QStringLiteral("h:mm:ss")));
-        avgWatt->setValue(QString::number(bluetoothManager->device()->wattsMetric().average(), 'f', 0));
-        wattKg->setValue(QString::number(bluetoothManager->device()->wattKg().value(), 'f', 1));
-        wattKg->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->wattKg().average(), 'f', 1) +
-            QStringLiteral("MAX: ") + QString::number(bluetoothManager->device()->wattKg().max(), 'f', 1));
-        datetime->setValue(QTime::currentTime().toString(QStringLiteral("hh:mm:ss")));
+        if (tileVisible(lapElapsed))
+            lapElapsed->setValue(bluetoothManager->device()->lapElapsedTime().toString(QStringLiteral("h:mm:ss")));
+        if (tileVisible(datetime))
+            datetime->setValue(QTime::currentTime().toString(QStringLiteral("hh:mm:ss")));
         if (power5s)
             watts = bluetoothManager->device()->wattsMetric().average5s();
         else
             watts = bluetoothManager->device()->wattsMetric().value();
-        watt->setValue(QString::number(watts, 'f', 0));
-        weightLoss->setValue(QString::number(miles ? bluetoothManager->device()->weightLoss() * 35.274
-                                                   : bluetoothManager->device()->weightLoss(),
-                                             'f', 2));
+        if (tileVisible(watt))
+            watt->setValue(QString::number(watts, 'f', 0));
+        if (tileVisible(weightLoss))
+            weightLoss->setValue(QString::number(miles ? bluetoothManager->device()->weightLoss() * 35.274
+                                                       : bluetoothManager->device()->weightLoss(),
+                                                 'f', 2));
 
         cadence = bluetoothManager->device()->currentCadence().value();
-        this->cadence->setValue(QString::number(cadence));
-        this->cadence->setSecondLine(
-            QStringLiteral("AVG: ") +
-            QString::number(((bike *)bluetoothManager->device())->currentCadence().average(), 'f', 0) +
-            QStringLiteral(" MAX: ") +
-            QString::number(((bike *)bluetoothManager->device())->currentCadence().max(), 'f', 0));
 
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
+        QSettings settings;
         if (settings.value(QZSettings::volume_change_gears, QZSettings::default_volume_change_gears).toBool()) {
             lockscreen h;
             static double volumeLast = -1;
@@ -2358,64 +1959,27 @@ void homeform::update() {
 
         if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
 
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
-            if (bluetoothManager->device()->currentSpeed().value()) {
-                pace = 10000 / (((treadmill *)bluetoothManager->device())->currentPace().second() +
-                                (((treadmill *)bluetoothManager->device())->currentPace().minute() * 60));
-                if (pace < 0) {
-                    pace = 0;
-                }
-            } else {
-
-                pace = 0;
+            if (tileVisible(odometer))
+                odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            if (tileVisible(this->pace)) {
+                this->pace->setValue(
+                    ((treadmill *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
+                this->pace->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    ((treadmill *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                    QStringLiteral(" MAX: ") +
+                    ((treadmill *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
+            }
+            if (tileVisible(elevation)) {
+                elevation->setValue(QString::number(((treadmill *)bluetoothManager->device())->elevationGain().value() *
+                                                        meter_feet_conversion,
+                                                    'f', (miles ? 0 : 1)));
+                elevation->setSecondLine(
+                    QString::number(((treadmill *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
+                                        meter_feet_conversion,
+                                    'f', (miles ? 0 : 1)) +
+                    " /min");
             }
-            strideLength = ((treadmill *)bluetoothManager->device())->currentStrideLength().value();
-            groundContact = ((treadmill *)bluetoothManager->device())->currentGroundContact().value();
-            verticalOscillation = ((treadmill *)bluetoothManager->device())->currentVerticalOscillation().value();
-            inclination = ((treadmill *)bluetoothManager->device())->currentInclination().value();
-            this->pace->setValue(
-                ((treadmill *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
-            this->pace->setSecondLine(
-                QStringLiteral("AVG: ") +
-                ((treadmill *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                QStringLiteral(" MAX: ") +
-                ((treadmill *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
-            this->inclination->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((treadmill *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
-            elevation->setSecondLine(
-                QString::number(((treadmill *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
-                                    meter_feet_conversion,
-                                'f', (miles ? 0 : 1)) +
-                " /min");
-            this->instantaneousStrideLengthCM->setValue(QString::number(strideLength, 'f', 0));
-            this->instantaneousStrideLengthCM->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentStrideLength().max(), 'f', 0));
-
-            this->groundContactMS->setValue(QString::number(groundContact, 'f', 0));
-            this->groundContactMS->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentGroundContact().max(), 'f', 0));
-
-            this->verticalOscillationMM->setValue(QString::number(verticalOscillation, 'f', 0));
-            this->verticalOscillationMM->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().average(), 'f',
-                                0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((treadmill *)bluetoothManager->device())->currentVerticalOscillation().max(), 'f', 0));
-
             if (bluetoothManager->device()->currentSpeed().value() < 9) {
                 speed->setValueFontColor(QStringLiteral("white"));
                 this->pace->setValueFontColor(QStringLiteral("white"));
@@ -2439,11 +2003,6 @@ void homeform::update() {
                 this->pace->setValueFontColor(QStringLiteral("red"));
             }
 
-            this->target_speed->setValue(QString::number(
-                ((treadmill *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
-            this->target_incline->setValue(
-                QString::number(((treadmill *)bluetoothManager->device())->lastRequestedInclination().value(), 'f', 1));
-
             // originally born for #470. When the treadmill reaches the 0 speed it enters in the pause mode
             // so this logic should care about sync the treadmill state to the UI state
             if (((treadmill *)bluetoothManager->device())->autoPauseWhenSpeedIsZero() &&
@@ -2458,10 +2017,7 @@ void homeform::update() {
 
         } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
 
-            bool pelotoncadence =
-                settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-
-            if (!pelotoncadence) {
+            if (!updateSettings.pelotonCadence && tileVisible(this->inclination)) {
                 inclination = ((bike *)bluetoothManager->device())->currentInclination().value();
                 this->inclination->setValue(QString::number(inclination, 'f', 1));
                 this->inclination->setSecondLine(
@@ -2470,122 +2026,61 @@ void homeform::update() {
                     QStringLiteral(" MAX: ") +
                     QString::number(((bike *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
             }
-            if (bluetoothManager->externalInclination())
-                extIncline->setValue(
-                    QString::number(bluetoothManager->externalInclination()->currentInclination().value(), 'f', 1));
-            double elite_rizer_gain =
-                settings.value(QZSettings::elite_rizer_gain, QZSettings::default_elite_rizer_gain).toDouble();
-            extIncline->setSecondLine(QStringLiteral("Gain: ") + QString::number(elite_rizer_gain, 'f', 1));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            if (tileVisible(extIncline)) {
+                if (bluetoothManager->externalInclination())
+                    extIncline->setValue(QString::number(
+                        bluetoothManager->externalInclination()->currentInclination().value(), 'f', 1));
+                extIncline->setSecondLine(QStringLiteral("Gain: ") +
+                                          QString::number(updateSettings.eliteRizerGain, 'f', 1));
+            }
+            if (tileVisible(odometer))
+                odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
             resistance = ((bike *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((bike *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
-            this->target_resistance->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((bike *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
-            this->target_cadence->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
-            this->target_power->setValue(
-                QString::number(((bike *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
-            this->gears->setValue(QString::number(((bike *)bluetoothManager->device())->gears()));
-
-            this->resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((bike *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((bike *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((bike *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((bike *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
-            this->target_resistance->setSecondLine(
-                QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
-                QString::number(
-                    bluetoothManager->device()->difficult() *
-                        settings.value(QZSettings::bike_resistance_gain_f, QZSettings::default_bike_resistance_gain_f)
-                            .toDouble() *
-                        settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset)
-                            .toDouble(),
-                    'f', 0));
-
-            elevation->setValue(
-                QString::number(((bike *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion,
-                                'f', (miles ? 0 : 1)));
-            elevation->setSecondLine(QString::number(((bike *)bluetoothManager->device())->elevationGain().rate1s() *
-                                                         60.0 * meter_feet_conversion,
-                                                     'f', (miles ? 0 : 1)) +
-                                     " /min");
-
-            this->steeringAngle->setValue(
-                QString::number(((bike *)bluetoothManager->device())->currentSteeringAngle().value(), 'f', 1));
+            if (tileVisible(this->gears)) {
+                this->gears->setValue(QString::number(((bike *)bluetoothManager->device())->gears()));
+                this->gears->setSecondLine(((bike *)bluetoothManager->device())->gearName());
+            }
+            if (tileVisible(this->target_resistance))
+                this->target_resistance->setSecondLine(
+                    QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) +
+                    QStringLiteral("% @0%=") +
+                    QString::number(bluetoothManager->device()->difficult() * updateSettings.resistanceGain *
+                                        updateSettings.resistanceOffset,
+                                    'f', 0));
+
+            if (tileVisible(elevation)) {
+                elevation->setValue(QString::number(((bike *)bluetoothManager->device())->elevationGain().value() *
+                                                        meter_feet_conversion,
+                                                    'f', (miles ? 0 : 1)));
+                elevation->setSecondLine(
+                    QString::number(((bike *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
+                                        meter_feet_conversion,
+                                    'f', (miles ? 0 : 1)) +
+                    " /min");
+            }
 
         } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
-            if (bluetoothManager->device()->currentSpeed().value()) {
-                pace = 10000 / (((rower *)bluetoothManager->device())->currentPace().second() +
-                                (((rower *)bluetoothManager->device())->currentPace().minute() * 60));
-                if (pace < 0) {
-                    pace = 0;
-                }
-            } else {
-
-                pace = 0;
+            if (tileVisible(this->pace)) {
+                this->pace->setValue(
+                    ((rower *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
+                this->pace->setSecondLine(
+                    QStringLiteral("AVG: ") +
+                    ((rower *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
+                    QStringLiteral(" MAX: ") +
+                    ((rower *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
             }
-            this->pace->setValue(((rower *)bluetoothManager->device())->currentPace().toString(QStringLiteral("m:ss")));
-            this->pace->setSecondLine(
-                QStringLiteral("AVG: ") +
-                ((rower *)bluetoothManager->device())->averagePace().toString(QStringLiteral("m:ss")) +
-                QStringLiteral(" MAX: ") +
-                ((rower *)bluetoothManager->device())->maxPace().toString(QStringLiteral("m:ss")));
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * 1000.0, 'f', 0));
+            if (tileVisible(odometer))
+                odometer->setValue(QString::number(bluetoothManager->device()->odometer() * 1000.0, 'f', 0));
             resistance = ((rower *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((rower *)bluetoothManager->device())->pelotonResistance().value();
-            totalStrokes = ((rower *)bluetoothManager->device())->currentStrokesCount().value();
-            avgStrokesRate = ((rower *)bluetoothManager->device())->currentCadence().average();
-            maxStrokesRate = ((rower *)bluetoothManager->device())->currentCadence().max();
-            avgStrokesLength = ((rower *)bluetoothManager->device())->currentStrokesLength().average();
-            this->strokesCount->setValue(
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesCount().value(), 'f', 0));
-            this->strokesLength->setValue(
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().value(), 'f', 1));
-
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
-            this->target_resistance->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((rower *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
-            this->target_cadence->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
-            this->target_power->setValue(
-                QString::number(((rower *)bluetoothManager->device())->lastRequestedPower().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance, 'f', 0));
-
-            this->resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentResistance().max(), 'f', 0));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
-            this->target_resistance->setSecondLine(
-                QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
-                QString::number(
-                    bluetoothManager->device()->difficult() *
-                        settings.value(QZSettings::bike_resistance_gain_f, QZSettings::default_bike_resistance_gain_f)
-                            .toDouble() *
-                        settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset)
-                            .toDouble(),
-                    'f', 0));
-            this->strokesLength->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((rower *)bluetoothManager->device())->currentStrokesLength().max(), 'f', 1));
+            if (tileVisible(this->target_resistance))
+                this->target_resistance->setSecondLine(
+                    QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) +
+                    QStringLiteral("% @0%=") +
+                    QString::number(bluetoothManager->device()->difficult() * updateSettings.resistanceGain *
+                                        updateSettings.resistanceOffset,
+                                    'f', 0));
             if (bluetoothManager->device()->currentSpeed().value() < 4) {
                 speed->setValueFontColor(QStringLiteral("white"));
                 this->pace->setValueFontColor(QStringLiteral("white"));
@@ -2610,69 +2105,50 @@ void homeform::update() {
             }
         } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) {
 
-            odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
+            if (tileVisible(odometer))
+                odometer->setValue(QString::number(bluetoothManager->device()->odometer() * unit_conversion, 'f', 2));
             resistance = ((elliptical *)bluetoothManager->device())->currentResistance().value();
             peloton_resistance = ((elliptical *)bluetoothManager->device())->pelotonResistance().value();
-            this->peloton_resistance->setValue(QString::number(peloton_resistance, 'f', 0));
-            this->target_resistance->setValue(
-                QString::number(((elliptical *)bluetoothManager->device())->lastRequestedResistance().value(), 'f', 0));
-            this->target_peloton_resistance->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedPelotonResistance().value(), 'f', 0));
-            this->resistance->setValue(QString::number(resistance));
-            this->peloton_resistance->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().average(), 'f', 0) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->pelotonResistance().max(), 'f', 0));
-            this->target_resistance->setSecondLine(
-                QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) + QStringLiteral("% @0%=") +
-                QString::number(
-                    bluetoothManager->device()->difficult() *
-                        settings.value(QZSettings::bike_resistance_gain_f, QZSettings::default_bike_resistance_gain_f)
-                            .toDouble() *
-                        settings.value(QZSettings::bike_resistance_offset, QZSettings::default_bike_resistance_offset)
-                            .toDouble(),
-                    'f', 0));
-            inclination = ((elliptical *)bluetoothManager->device())->currentInclination().value();
-            this->inclination->setValue(QString::number(inclination, 'f', 1));
-            this->inclination->setSecondLine(
-                QStringLiteral("AVG: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->currentInclination().average(), 'f', 1) +
-                QStringLiteral(" MAX: ") +
-                QString::number(((elliptical *)bluetoothManager->device())->currentInclination().max(), 'f', 1));
-            elevation->setValue(QString::number(((elliptical *)bluetoothManager->device())->elevationGain().value() *
-                                                    meter_feet_conversion,
-                                                'f', (miles ? 0 : 1)));
-            elevation->setSecondLine(
-                QString::number(((elliptical *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
-                                    meter_feet_conversion,
-                                'f', (miles ? 0 : 1)) +
-                " /min");
-            this->target_speed->setValue(QString::number(
-                ((elliptical *)bluetoothManager->device())->lastRequestedSpeed().value() * unit_conversion, 'f', 1));
-
-            this->target_cadence->setValue(
-                QString::number(((elliptical *)bluetoothManager->device())->lastRequestedCadence().value(), 'f', 0));
+            if (tileVisible(this->resistance))
+                this->resistance->setValue(QString::number(resistance));
+            if (tileVisible(this->target_resistance))
+                this->target_resistance->setSecondLine(
+                    QString::number(bluetoothManager->device()->difficult() * 100.0, 'f', 0) +
+                    QStringLiteral("% @0%=") +
+                    QString::number(bluetoothManager->device()->difficult() * updateSettings.resistanceGain *
+                                        updateSettings.resistanceOffset,
+                                    'f', 0));
+            if (tileVisible(elevation)) {
+                elevation->setValue(QString::number(
+                    ((elliptical *)bluetoothManager->device())->elevationGain().value() * meter_feet_conversion, 'f',
+                    (miles ? 0 : 1)));
+                elevation->setSecondLine(
+                    QString::number(((elliptical *)bluetoothManager->device())->elevationGain().rate1s() * 60.0 *
+                                        meter_feet_conversion,
+                                    'f', (miles ? 0 : 1)) +
+                    " /min");
+            }
         }
-        watt->setSecondLine(
-            QStringLiteral("AVG: ") + QString::number((bluetoothManager->device())->wattsMetric().average(), 'f', 0) +
-            QStringLiteral(" MAX: ") + QString::number((bluetoothManager->device())->wattsMetric().max(), 'f', 0));
+        if (tileVisible(watt))
+            watt->setSecondLine(QStringLiteral("AVG: ") +
+                                QString::number((bluetoothManager->device())->wattsMetric().average(), 'f', 0) +
+                                QStringLiteral(" MAX: ") +
+                                QString::number((bluetoothManager->device())->wattsMetric().max(), 'f', 0));
 
         if (trainProgram) {
             int8_t lower_requested_peloton_resistance = trainProgram->currentRow().lower_requested_peloton_resistance;
             int8_t upper_requested_peloton_resistance = trainProgram->currentRow().upper_requested_peloton_resistance;
-            if (lower_requested_peloton_resistance != -1) {
-                this->target_peloton_resistance->setSecondLine(
-                    QStringLiteral("MIN: ") + QString::number(lower_requested_peloton_resistance, 'f', 0) +
-                    QStringLiteral(" MAX: ") + QString::number(upper_requested_peloton_resistance, 'f', 0));
-            } else {
-                this->target_peloton_resistance->setSecondLine(QLatin1String(""));
+            if (tileVisible(this->target_peloton_resistance)) {
+                if (lower_requested_peloton_resistance != -1) {
+                    this->target_peloton_resistance->setSecondLine(
+                        QStringLiteral("MIN: ") + QString::number(lower_requested_peloton_resistance, 'f', 0) +
+                        QStringLiteral(" MAX: ") + QString::number(upper_requested_peloton_resistance, 'f', 0));
+                } else {
+                    this->target_peloton_resistance->setSecondLine(QLatin1String(""));
+                }
             }
 
-            if (settings
-                    .value(QZSettings::tile_peloton_resistance_color_enabled,
-                           QZSettings::default_tile_peloton_resistance_color_enabled)
-                    .toBool()) {
+            if (updateSettings.pelotonResistanceColor) {
                 if (lower_requested_peloton_resistance == -1) {
                     this->peloton_resistance->setValueFontColor(QStringLiteral("white"));
                 } else if (((int8_t)peloton_resistance) < lower_requested_peloton_resistance) {
@@ -2686,15 +2162,18 @@ void homeform::update() {
 
             int16_t lower_cadence = trainProgram->currentRow().lower_cadence;
             int16_t upper_cadence = trainProgram->currentRow().upper_cadence;
-            if (lower_cadence != -1) {
-                this->target_cadence->setSecondLine(QStringLiteral("MIN: ") + QString::number(lower_cadence, 'f', 0) +
-                                                    QStringLiteral(" MAX: ") + QString::number(upper_cadence, 'f', 0));
-            } else {
-                this->target_cadence->setSecondLine(QLatin1String(""));
+            if (tileVisible(this->target_cadence)) {
+                if (lower_cadence != -1) {
+                    this->target_cadence->setSecondLine(QStringLiteral("MIN: ") +
+                                                        QString::number(lower_cadence, 'f', 0) +
+                                                        QStringLiteral(" MAX: ") +
+                                                        QString::number(upper_cadence, 'f', 0));
+                } else {
+                    this->target_cadence->setSecondLine(QLatin1String(""));
+                }
             }
 
-            if (settings.value(QZSettings::tile_cadence_color_enabled, QZSettings::default_tile_cadence_color_enabled)
-                    .toBool()) {
+            if (updateSettings.cadenceColor) {
                 if (lower_cadence == -1) {
                     this->cadence->setValueFontColor(QStringLiteral("white"));
                 } else if (cadence < lower_cadence) {
@@ -2800,9 +2279,11 @@ void homeform::update() {
             watt->setValueFontColor(QStringLiteral("red"));
         }
         bluetoothManager->device()->setPowerZone(ftpZone);
-        ftp->setValue(QStringLiteral("Z") + QString::number(ftpZone, 'f', 1));
-        ftp->setSecondLine(ftpMinW + QStringLiteral("-") + ftpMaxW + QStringLiteral("W ") +
-                           QString::number(ftpPerc, 'f', 0) + QStringLiteral("%"));
+        if (tileVisible(ftp)) {
+            ftp->setValue(QStringLiteral("Z") + QString::number(ftpZone, 'f', 1));
+            ftp->setSecondLine(ftpMinW + QStringLiteral("-") + ftpMaxW + QStringLiteral("W ") +
+                               QString::number(ftpPerc, 'f', 0) + QStringLiteral("%"));
+        }
 
         if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE ||
             bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
@@ -2874,71 +2355,44 @@ void homeform::update() {
 
                 target_zone->setValueFontColor(QStringLiteral("red"));
             }
-            target_zone->setValue(QStringLiteral("Z") + QString::number(requestedZone, 'f', 1));
-            target_zone->setSecondLine(requestedMinW + QStringLiteral("-") + requestedMaxW + QStringLiteral("W ") +
-                                       QString::number(requestedPerc, 'f', 0) + QStringLiteral("%"));
+            if (tileVisible(target_zone)) {
+                target_zone->setValue(QStringLiteral("Z") + QString::number(requestedZone, 'f', 1));
+                target_zone->setSecondLine(requestedMinW + QStringLiteral("-") + requestedMaxW +
+                                           QStringLiteral("W ") + QString::number(requestedPerc, 'f', 0) +
+                                           QStringLiteral("%"));
+            }
         }
 
         QString Z;
-        double maxHeartRate = heartRateMax();
-        double percHeartRate = (bluetoothManager->device()->currentHeart().value() * 100) / maxHeartRate;
-
-        if (percHeartRate <
-            settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) {
-            currentHRZone = 1;
-            currentHRZone +=
-                (percHeartRate /
-                 settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble());
-            if (currentHRZone >= 2) { // double precision could cause unwanted approximation
-                currentHRZone = 1.9999;
-            }
+        double maxHeartRate = updateSettings.heartRateMax;
+        currentHRZone = heartZone(bluetoothManager->device()->currentHeart().value());
+        switch ((int)currentHRZone) {
+        case 1:
             heart->setValueFontColor(QStringLiteral("lightsteelblue"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) {
-            currentHRZone = 2;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()));
-            if (currentHRZone >= 3) { // double precision could cause unwanted approximation
-                currentHRZone = 2.9999;
-            }
+            break;
+        case 2:
             heart->setValueFontColor(QStringLiteral("green"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) {
-            currentHRZone = 3;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()));
-            if (currentHRZone >= 4) { // double precision could cause unwanted approximation
-                currentHRZone = 3.9999;
-            }
+            break;
+        case 3:
             heart->setValueFontColor(QStringLiteral("yellow"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble()) {
-            currentHRZone = 4;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()));
-            if (currentHRZone >= 5) { // double precision could cause unwanted approximation
-                currentHRZone = 4.9999;
-            }
+            break;
+        case 4:
             heart->setValueFontColor(QStringLiteral("orange"));
-        } else {
-            currentHRZone = 5;
+            break;
+        default:
             heart->setValueFontColor(QStringLiteral("red"));
+            break;
         }
         bluetoothManager->device()->setHeartZone(currentHRZone);
-        Z = QStringLiteral("Z") + QString::number(currentHRZone, 'f', 1);
-        heart->setSecondLine(Z + QStringLiteral(" AVG: ") +
-                             QString::number((bluetoothManager->device())->currentHeart().average(), 'f', 0) +
-                             QStringLiteral(" MAX: ") +
-                             QString::number((bluetoothManager->device())->currentHeart().max(), 'f', 0));
+        // the inclination read back after the commands gives the dead time and the slew rate of the device
+        bluetoothManager->device()->learnInclinationFeedback();
+        if (tileVisible(heart)) {
+            Z = QStringLiteral("Z") + QString::number(currentHRZone, 'f', 1);
+            heart->setSecondLine(Z + QStringLiteral(" AVG: ") +
+                                 QString::number((bluetoothManager->device())->currentHeart().average(), 'f', 0) +
+                                 QStringLiteral(" MAX: ") +
+                                 QString::number((bluetoothManager->device())->currentHeart().max(), 'f', 0));
+        }
 
         /*
                 if(trainProgram)
@@ -2958,15 +2412,15 @@ void homeform::update() {
         */
 
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_cadence, QZSettings::default_ant_cadence).toBool() &&
-            KeepAwakeHelper::antObject(false)) {
+        if (updateSettings.antCadence && KeepAwakeHelper::antObject(false)) {
             KeepAwakeHelper::antObject(false)->callMethod<void>(
                 "setCadenceSpeedPower", "(FII)V", (float)bluetoothManager->device()->currentSpeed().value(), (int)watts,
                 (int)cadence);
         }
 #endif
 
-        if (settings.value(QZSettings::trainprogram_random, QZSettings::default_trainprogram_random).toBool()) {
+        if (updateSettings.trainProgramRandom) {
+            QSettings settings;
             if (!paused && !stopped) {
 
                 static QRandomGenerator r;
@@ -3116,109 +2570,17 @@ void homeform::update() {
                     }
                 }
             }
-        } else if (!settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
-                        .toString()
-                        .contains(QStringLiteral("Disabled")) ||
-                   (trainProgram && trainProgram->currentRow().zoneHR > 0)) {
-            static uint32_t last_seconds_pid_heart_zone = 0;
-            static uint32_t pid_heart_zone_small_inc_counter = 0;
-            uint32_t seconds = bluetoothManager->device()->elapsedTime().second() +
-                               (bluetoothManager->device()->elapsedTime().minute() * 60) +
-                               (bluetoothManager->device()->elapsedTime().hour() * 3600);
-            uint8_t delta = 10;
-            bool fromTrainProgram = trainProgram && trainProgram->currentRow().zoneHR > 0;
-            int8_t maxSpeed = 30;
-
-            if (fromTrainProgram) {
-                delta = trainProgram->currentRow().loopTimeHR;
-            }
-
-            if (last_seconds_pid_heart_zone == 0 || ((seconds - last_seconds_pid_heart_zone) >= delta)) {
-
-                last_seconds_pid_heart_zone = seconds;
-
-                uint8_t zone =
-                    settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
-                        .toString()
-                        .toUInt();
-                if (fromTrainProgram) {
-                    zone = trainProgram->currentRow().zoneHR;
-                    if (trainProgram->currentRow().maxSpeed > 0) {
-                        maxSpeed = trainProgram->currentRow().maxSpeed;
-                    }
-                }
-
-                if (!stopped && !paused && bluetoothManager->device()->currentHeart().value() &&
-                    bluetoothManager->device()->currentSpeed().value() > 0.0f) {
-                    if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
-
-                        const double step = 0.2;
-                        double currentSpeed = ((treadmill *)bluetoothManager->device())->currentSpeed().value();
-                        if (zone < ((uint8_t)currentHRZone)) {
-                            ((treadmill *)bluetoothManager->device())
-                                ->changeSpeedAndInclination(
-                                    currentSpeed - step,
-                                    ((treadmill *)bluetoothManager->device())->currentInclination().value());
-                            pid_heart_zone_small_inc_counter = 0;
-                        } else if (zone > ((uint8_t)currentHRZone) && maxSpeed >= currentSpeed + step) {
-                            ((treadmill *)bluetoothManager->device())
-                                ->changeSpeedAndInclination(
-
-                                    currentSpeed + step,
-                                    ((treadmill *)bluetoothManager->device())->currentInclination().value());
-                            pid_heart_zone_small_inc_counter = 0;
-                        } else {
-                            pid_heart_zone_small_inc_counter++;
-                            if (pid_heart_zone_small_inc_counter > 6) {
-                                ((treadmill *)bluetoothManager->device())
-                                    ->changeSpeedAndInclination(
-                                        currentSpeed + step,
-                                        ((treadmill *)bluetoothManager->device())->currentInclination().value());
-                                pid_heart_zone_small_inc_counter = 0;
-                            }
-                        }
-                    } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE) {
-
-                        const int step = 1;
-                        resistance_t currentResistance =
-                            ((bike *)bluetoothManager->device())->currentResistance().value();
-                        if (zone < ((uint8_t)currentHRZone)) {
-
-                            ((bike *)bluetoothManager->device())->changeResistance(currentResistance - step);
-                        } else if (zone > ((uint8_t)currentHRZone)) {
-
-                            ((bike *)bluetoothManager->device())->changeResistance(currentResistance + step);
-                        }
-                    } else if (bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
-
-                        const int step = 1;
-                        resistance_t currentResistance =
-                            ((rower *)bluetoothManager->device())->currentResistance().value();
-                        if (zone < ((uint8_t)currentHRZone)) {
-
-                            ((rower *)bluetoothManager->device())->changeResistance(currentResistance - step);
-                        } else if (zone > ((uint8_t)currentHRZone)) {
-
-                            ((rower *)bluetoothManager->device())->changeResistance(currentResistance + step);
-                        }
-                    }
-                }
-            }
         }
 
-        if (settings.value(QZSettings::fitmetria_fanfit_enable, QZSettings::default_fitmetria_fanfit_enable).toBool()) {
-            if (!settings.value(QZSettings::fitmetria_fanfit_mode, QZSettings::default_fitmetria_fanfit_mode)
-                     .toString()
-                     .compare(QStringLiteral("Manual"))) {
+        if (updateSettings.fanfitEnabled) {
+            if (!updateSettings.fanfitMode.compare(QStringLiteral("Manual"))) {
                 // do nothing here, the user change the fan value with the tile
             } else if (paused || stopped) {
                 qDebug() << QStringLiteral("fitmetria_fanfit paused or stopped mode");
                 bluetoothManager->device()->changeFanSpeed(0);
             }
             // Heart Mode
-            else if (!settings.value(QZSettings::fitmetria_fanfit_mode, QZSettings::default_fitmetria_fanfit_mode)
-                          .toString()
-                          .compare(QStringLiteral("Heart"))) {
+            else if (!updateSettings.fanfitMode.compare(QStringLiteral("Heart"))) {
                 qDebug() << QStringLiteral("fitmetria_fanfit heart mode")
                          << bluetoothManager->device()->currentHeart().value();
                 const uint8_t min = 80;
@@ -3229,9 +2591,7 @@ void homeform::update() {
                 bluetoothManager->device()->changeFanSpeed(v + fanOverride);
             }
             // Power Mode
-            else if (!settings.value(QZSettings::fitmetria_fanfit_mode, QZSettings::default_fitmetria_fanfit_mode)
-                          .toString()
-                          .compare(QStringLiteral("Power"))) {
+            else if (!updateSettings.fanfitMode.compare(QStringLiteral("Power"))) {
                 qDebug() << QStringLiteral("fitmetria_fanfit power mode") << watts;
                 const double percOverFtp = 1.20;
                 const double min = 50;
@@ -3242,9 +2602,7 @@ void homeform::update() {
                 bluetoothManager->device()->changeFanSpeed(v + fanOverride);
             }
             // Wind mode
-            else if (!settings.value(QZSettings::fitmetria_fanfit_mode, QZSettings::default_fitmetria_fanfit_mode)
-                          .toString()
-                          .compare(QStringLiteral("Wind"))) {
+            else if (!updateSettings.fanfitMode.compare(QStringLiteral("Wind"))) {
                 // Todo
                 qDebug() << QStringLiteral("fitmetria_fanfit wind mode");
                 // bluetoothManager->device()->changeFanSpeed((ftpZone - 1) * 1.5);
@@ -3252,14 +2610,14 @@ void homeform::update() {
         }
 
         if (!stopped && !paused) {
-            if (settings.value(QZSettings::tts_enabled, QZSettings::default_tts_enabled).toBool()) {
-                bool description =
-                    settings.value(QZSettings::tts_description_enabled, QZSettings::default_tts_description_enabled)
-                        .toBool();
-                if (++tts_summary_count >=
-                        settings.value(QZSettings::tts_summary_sec, QZSettings::default_tts_summary_sec).toInt() &&
+            if (updateSettings.ttsEnabled) {
+                bool description = updateSettings.ttsDescription;
+                // the ui refresh interval is configurable, so the summary period is measured in milliseconds
+                tts_summary_elapsed_ms += timer->interval();
+                if (tts_summary_elapsed_ms >= updateSettings.ttsSummarySec * 1000 &&
                     m_speech.state() == QTextToSpeech::Ready) {
-                    tts_summary_count = 0;
+                    tts_summary_elapsed_ms = 0;
+                    QSettings settings;
 
                     QString s;
                     if (settings.value(QZSettings::tts_act_speed, QZSettings::default_tts_act_speed).toBool())
@@ -3450,30 +2808,205 @@ void homeform::update() {
                     m_speech.say(s);
                 }
             }
+        }
+        emit workoutStartDateChanged(workoutStartDate());
+    }
 
-            SessionLine s(
-                bluetoothManager->device()->currentSpeed().value(), inclination, bluetoothManager->device()->odometer(),
-                watts, resistance, peloton_resistance, (uint8_t)bluetoothManager->device()->currentHeart().value(),
-                pace, cadence, bluetoothManager->device()->calories().value(),
-                bluetoothManager->device()->elevationGain().value(),
-                bluetoothManager->device()->elapsedTime().second() +
-                    (bluetoothManager->device()->elapsedTime().minute() * 60) +
-                    (bluetoothManager->device()->elapsedTime().hour() * 3600),
+    emit changeOfdevice();
+    emit changeOflap();
+}
 
-                lapTrigger, totalStrokes, avgStrokesRate, maxStrokesRate, avgStrokesLength,
-                bluetoothManager->device()->currentCordinate(), strideLength, groundContact, verticalOscillation);
+// the zone of a heart rate, with the fraction of the zone: 2.5 is the middle of the zone 2
+double homeform::heartZone(double heart) const {
+    const double *zones = updateSettings.heartRateZone;
+    double perc = (heart * 100) / updateSettings.heartRateMax;
+    int base = 1;
+    while (base < 5 && perc >= zones[base - 1])
+        base++;
+    if (base == 5)
+        return 5;
+    double from = base > 1 ? zones[base - 2] : 0;
+    double zone = base + ((perc - from) / (zones[base - 1] - from));
+    if (zone >= base + 1) { // double precision could cause unwanted approximation
+        zone = base + 0.9999;
+    }
+    return zone;
+}
 
-            Session.append(s);
+// the heart rate zone controller (treadmill_pid_heart_zone or the zoneHR of the program), stepped by the session
+// sampler and not by the ui refresh, so its timing doesn't depend on ui_refresh_interval_ms
+void homeform::updateHeartZoneController() {
+    if (!bluetoothManager->device() || updateSettings.trainProgramRandom ||
+        (!updateSettings.pidHeartZone && !(trainProgram && trainProgram->currentRow().zoneHR > 0))) {
+        return;
+    }
 
-            if (lapTrigger) {
-                lapTrigger = false;
+    double currentHRZone = heartZone(bluetoothManager->device()->currentHeart().value());
+    uint32_t seconds = bluetoothManager->device()->elapsedTime().second() +
+                       (bluetoothManager->device()->elapsedTime().minute() * 60) +
+                       (bluetoothManager->device()->elapsedTime().hour() * 3600);
+    bool fromTrainProgram = trainProgram && trainProgram->currentRow().zoneHR > 0;
+    bluetoothdevice::BLUETOOTH_TYPE deviceType = bluetoothManager->device()->deviceType();
+    uint32_t sampleTime = updateSettings.pidSampleTime;
+    uint8_t zone = updateSettings.pidHeartZone;
+    double maxSpeed = 30;
+
+    if (fromTrainProgram) {
+        sampleTime = trainProgram->currentRow().loopTimeHR;
+        zone = trainProgram->currentRow().zoneHR;
+        if (trainProgram->currentRow().maxSpeed > 0) {
+            maxSpeed = trainProgram->currentRow().maxSpeed;
+        }
+    }
+
+    QString actuatorName = updateSettings.pidActuator;
+    heartratezonecontroller::ACTUATOR actuator =
+        heartratezonecontroller::actuatorFromString(actuatorName, deviceType == bluetoothdevice::TREADMILL);
+    // the actuators that the device doesn't have fall back to the default one
+    if ((actuator == heartratezonecontroller::SPEED && deviceType != bluetoothdevice::TREADMILL) ||
+        (actuator == heartratezonecontroller::RESISTANCE && deviceType == bluetoothdevice::TREADMILL) ||
+        (actuator == heartratezonecontroller::POWER && deviceType != bluetoothdevice::BIKE) ||
+        (actuator == heartratezonecontroller::INCLINATION && deviceType == bluetoothdevice::ROWING)) {
+        actuatorName = QStringLiteral("Auto");
+        actuator = heartratezonecontroller::actuatorFromString(actuatorName, deviceType == bluetoothdevice::TREADMILL);
+    }
+    // the other devices (the ellipticals) have no default actuator, as before the controller: they follow the zone
+    // only with an explicit inclination or resistance actuator
+    bool hasActuator = actuatorName != QStringLiteral("Auto") || deviceType == bluetoothdevice::TREADMILL ||
+                       deviceType == bluetoothdevice::BIKE || deviceType == bluetoothdevice::ROWING;
+
+    double currentValue = 0;
+    switch (actuator) {
+    case heartratezonecontroller::SPEED:
+        heartZoneController.setActuator(actuator, 0.2, 1, maxSpeed, 6);
+        currentValue = bluetoothManager->device()->currentSpeed().value();
+        break;
+    case heartratezonecontroller::INCLINATION:
+        heartZoneController.setActuator(actuator, 0.5, 0, 15);
+        currentValue = bluetoothManager->device()->currentInclination().value();
+        break;
+    case heartratezonecontroller::RESISTANCE:
+        heartZoneController.setActuator(actuator, 1, 1, bluetoothManager->device()->maxResistance());
+        currentValue = bluetoothManager->device()->currentResistance().value();
+        break;
+    case heartratezonecontroller::POWER:
+        heartZoneController.setActuator(actuator, 10, 50, 1000);
+        currentValue = ((bike *)bluetoothManager->device())->lastRequestedPower().value();
+        if (currentValue <= 0) {
+            currentValue = bluetoothManager->device()->wattsMetric().value();
+        }
+        break;
+    }
+    heartZoneController.setSampleTime(sampleTime);
+    heartZoneController.setGains(updateSettings.pidKp, updateSettings.pidKi, updateSettings.pidKd);
+
+    double value;
+    if (hasActuator && !stopped && !paused && bluetoothManager->device()->currentHeart().value() &&
+        bluetoothManager->device()->currentSpeed().value() > 0.0f &&
+        heartZoneController.update(seconds, zone, currentHRZone, currentValue, &value)) {
+        switch (actuator) {
+        case heartratezonecontroller::SPEED:
+            ((treadmill *)bluetoothManager->device())
+                ->changeSpeedAndInclination(
+                    value, ((treadmill *)bluetoothManager->device())->currentInclination().value());
+            break;
+        case heartratezonecontroller::INCLINATION:
+            if (deviceType == bluetoothdevice::TREADMILL) {
+                ((treadmill *)bluetoothManager->device())
+                    ->changeSpeedAndInclination(bluetoothManager->device()->currentSpeed().value(), value);
+            } else {
+                bluetoothManager->device()->changeInclination(value, value);
             }
+            break;
+        case heartratezonecontroller::RESISTANCE:
+            bluetoothManager->device()->changeResistance(qRound(value));
+            break;
+        case heartratezonecontroller::POWER:
+            bluetoothManager->device()->changePower(qRound(value));
+            break;
         }
-        emit workoutStartDateChanged(workoutStartDate());
+    }}
+
+void homeform::sample() {
+    if (!bluetoothManager->device() || stopped || paused) {
+        return;
     }
 
-    emit changeOfdevice();
-    emit changeOflap();
+    bluetoothdevice *dev = bluetoothManager->device();
+    double inclination = 0;
+    double resistance = 0;
+    double watts = 0;
+    double pace = 0;
+    double peloton_resistance = 0;
+    uint8_t cadence = dev->currentCadence().value();
+    uint32_t totalStrokes = 0;
+    double avgStrokesRate = 0;
+    double maxStrokesRate = 0;
+    double avgStrokesLength = 0;
+    double strideLength = 0;
+    double groundContact = 0;
+    double verticalOscillation = 0;
+
+    if (updateSettings.power5s)
+        watts = dev->wattsMetric().average5s();
+    else
+        watts = dev->wattsMetric().value();
+
+    if (dev->deviceType() == bluetoothdevice::TREADMILL) {
+        if (dev->currentSpeed().value()) {
+            pace = 10000 / (((treadmill *)dev)->currentPace().second() + (((treadmill *)dev)->currentPace().minute() * 60));
+            if (pace < 0) {
+                pace = 0;
+            }
+        }
+        strideLength = ((treadmill *)dev)->currentStrideLength().value();
+        groundContact = ((treadmill *)dev)->currentGroundContact().value();
+        verticalOscillation = ((treadmill *)dev)->currentVerticalOscillation().value();
+        inclination = ((treadmill *)dev)->currentInclination().value();
+    } else if (dev->deviceType() == bluetoothdevice::BIKE) {
+        if (!updateSettings.pelotonCadence) {
+            inclination = ((bike *)dev)->currentInclination().value();
+        }
+        resistance = ((bike *)dev)->currentResistance().value();
+        peloton_resistance = ((bike *)dev)->pelotonResistance().value();
+    } else if (dev->deviceType() == bluetoothdevice::ROWING) {
+        if (dev->currentSpeed().value()) {
+            pace = 10000 / (((rower *)dev)->currentPace().second() + (((rower *)dev)->currentPace().minute() * 60));
+            if (pace < 0) {
+                pace = 0;
+            }
+        }
+        resistance = ((rower *)dev)->currentResistance().value();
+        peloton_resistance = ((rower *)dev)->pelotonResistance().value();
+        totalStrokes = ((rower *)dev)->currentStrokesCount().value();
+        avgStrokesRate = ((rower *)dev)->currentCadence().average();
+        maxStrokesRate = ((rower *)dev)->currentCadence().max();
+        avgStrokesLength = ((rower *)dev)->currentStrokesLength().average();
+    } else if (dev->deviceType() == bluetoothdevice::ELLIPTICAL) {
+        resistance = ((elliptical *)dev)->currentResistance().value();
+        peloton_resistance = ((elliptical *)dev)->pelotonResistance().value();
+        inclination = ((elliptical *)dev)->currentInclination().value();
+    }
+
+    SessionLine s(dev->currentSpeed().value(), inclination, dev->odometer(), watts, resistance, peloton_resistance,
+                  (uint8_t)dev->currentHeart().value(), pace, cadence, dev->calories().value(),
+                  dev->elevationGain().value(),
+                  dev->elapsedTime().second() + (dev->elapsedTime().minute() * 60) +
+                      (dev->elapsedTime().hour() * 3600),
+
+                  lapTrigger, totalStrokes, avgStrokesRate, maxStrokesRate, avgStrokesLength,
+                  dev->currentCordinate(), strideLength, groundContact, verticalOscillation);
+    s.sampleIntervalMs = sampleTimer->interval();
+
+    Session.append(s);
+    chartModel->append(s);
+    pathController.appendRiddenPoint(s.coordinate);
+
+    if (lapTrigger) {
+        lapTrigger = false;
+    }
+
+    updateHeartZoneController();
 }
 
 bool homeform::getDevice() {
@@ -3522,14 +3055,16 @@ void homeform::trainprogram_preview(const QUrl &fileName) {
     qDebug() << file.fileName();
     if (!file.fileName().isEmpty()) {
         {
-            if (previewTrainProgram) {
-
-                delete previewTrainProgram;
+            // from the index of the library, parsed here only when the file is new or changed
+            previewEntry = workoutLibrary->find(file.fileName());
+            if (!previewEntry.isValid()) {
+                previewEntry = workoutlibrary::parse(file.fileName());
+                workoutLibrary->index(workoutFolders());
             }
-            previewTrainProgram = trainprogram::load(file.fileName(), bluetoothManager);
             emit previewWorkoutPointsChanged(preview_workout_points());
             emit previewWorkoutDescriptionChanged(previewWorkoutDescription());
             emit previewWorkoutTagsChanged(previewWorkoutTags());
+            emit previewWorkoutSummaryChanged(previewWorkoutSummary());
         }
     }
 }
@@ -4542,6 +4077,7 @@ void homeform::loadSettings(const QUrl &filename) {
             }
         }
     }
+    settingsChanged();
 }
 
 void homeform::deleteSettings(const QUrl &filename) { QFile(filename.toLocalFile()).remove(); }
@@ -4606,12 +4142,10 @@ void homeform::clearFiles() {
     }
 }
 
-int homeform::preview_workout_points() {
-    if (previewTrainProgram) {
-        QTime d = previewTrainProgram->duration();
-        return (d.hour() * 3600) + (d.minute() * 60) + d.second();
-    }
-    return 0;
+int homeform::preview_workout_points() { return qRound(previewEntry.duration); }
+
+QStringList homeform::workoutFolders() {
+    return {getWritableAppDir() + QStringLiteral("training"), getWritableAppDir() + QStringLiteral("gpx")};
 }
 
 #if defined(Q_OS_WIN) || (defined(Q_OS_MAC) && !defined(Q_OS_IOS))
@@ -5,11 +5,14 @@
 #include "bluetooth.h"
 #include "fit_profile.hpp"
 #include "gpx.h"
+#include "heartratezonecontroller.h"
 #include "peloton.h"
 #include "screencapture.h"
 #include "sessionline.h"
 #include "smtpclient/src/SmtpMime"
 #include "trainprogram.h"
+#include "workoutlibrary.h"
+#include "workoutchartmodel.h"
 #include <QChart>
 #include <QColor>
 #include <QGraphicsScene>
@@ -19,7 +22,9 @@
 #include <QQmlApplicationEngine>
 #include <QQuickItem>
 #include <QQuickItemGrabResult>
+#include <QSet>
 #include <QTextToSpeech>
+#include <functional>
 
 class DataObject : public QObject {
 
@@ -92,6 +97,36 @@ class DataObject : public QObject {
     void minusNameChanged(QString value);
 };
 
+// a tile fed by a single device metric: homeform::updateTileBindings() formats it only when the tile is shown
+class TileBinding {
+  public:
+    enum UNIT { NONE = 0, SPEED }; // SPEED is converted to mph when miles_unit is set
+    enum SECOND_LINE { NO_SECOND_LINE = 0, AVG_MAX, RATE_PER_MINUTE };
+
+    DataObject *tile;
+    std::function<metric(bluetoothdevice *)> accessor;
+    int decimals;
+    UNIT unit = NONE;
+    SECOND_LINE secondLine = NO_SECOND_LINE;
+    double scale = 1.0;
+    bool average = false;                                                 // show the average instead of the value
+    bluetoothdevice::BLUETOOTH_TYPE deviceType = bluetoothdevice::UNKNOWN; // UNKNOWN means any device
+
+    // formats the metric of dev in the tile
+    void update(bluetoothdevice *dev, bool miles) const;
+};
+
+// a tile of the grid with the settings that enable and place it, see homeform::tileLayoutEntries()
+class TileLayoutEntry {
+  public:
+    QString enabledKey;
+    bool enabledDefault;
+    QString orderKey;
+    int orderDefault;
+    DataObject *tile;
+    bool available = true;
+};
+
 class homeform : public QObject {
 
     Q_OBJECT
@@ -128,12 +163,7 @@ class homeform : public QObject {
     Q_PROPERTY(QString workoutStartDate READ workoutStartDate)
     Q_PROPERTY(QString workoutName READ workoutName)
     Q_PROPERTY(QString instructorName READ instructorName)
-    Q_PROPERTY(int workout_sample_points READ workout_sample_points)
-    Q_PROPERTY(QList<double> workout_watt_points READ workout_watt_points)
-    Q_PROPERTY(QList<double> workout_heart_points READ workout_heart_points)
-    Q_PROPERTY(QList<double> workout_cadence_points READ workout_cadence_points)
-    Q_PROPERTY(QList<double> workout_peloton_resistance_points READ workout_peloton_resistance_points)
-    Q_PROPERTY(QList<double> workout_resistance_points READ workout_resistance_points)
+    Q_PROPERTY(workoutchartmodel *workout_chart READ workout_chart CONSTANT)
     Q_PROPERTY(double wattMaxChart READ wattMaxChart)
     Q_PROPERTY(bool autoResistance READ autoResistance NOTIFY autoResistanceChanged WRITE setAutoResistance)
 
@@ -142,6 +172,7 @@ class homeform : public QObject {
     Q_PROPERTY(QList<double> preview_workout_watt READ preview_workout_watt)
     Q_PROPERTY(QString previewWorkoutDescription READ previewWorkoutDescription NOTIFY previewWorkoutDescriptionChanged)
     Q_PROPERTY(QString previewWorkoutTags READ previewWorkoutTags NOTIFY previewWorkoutTagsChanged)
+    Q_PROPERTY(QString previewWorkoutSummary READ previewWorkoutSummary NOTIFY previewWorkoutSummaryChanged)
 
     Q_PROPERTY(bool currentCoordinateValid READ currentCoordinateValid)
 
@@ -371,7 +402,7 @@ class homeform : public QObject {
     void setVideoRate(double rate);
     void setMapsVisible(bool value);
     void setGeneralPopupVisible(bool value);
-    int workout_sample_points() { return Session.count(); }
+    workoutchartmodel *workout_chart() { return chartModel; }
     int preview_workout_points();
 
 #if defined(Q_OS_ANDROID)
@@ -395,77 +426,29 @@ class homeform : public QObject {
     Q_INVOKABLE void sendMail();
 
     Q_INVOKABLE void sortTiles();
+    Q_INVOKABLE void invalidateTileLayout();
+    // a Settings item of a QML page: the caches of the settings are refreshed when its properties change
+    Q_INVOKABLE void watchSettings(QObject *qmlSettings);
     Q_INVOKABLE void moveTile(QString name, int newIndex, int oldIndex);
     DataObject *tileFromName(QString name);
-
-    QList<double> workout_watt_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.watt);
-        }
-        return l;
-    }
-    QList<double> workout_heart_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.heart);
-        }
-        return l;
-    }
-    QList<double> workout_cadence_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.cadence);
-        }
-        return l;
-    }
-    QList<double> workout_resistance_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.resistance);
-        }
-        return l;
-    }
-    QList<double> workout_peloton_resistance_points() {
-        QList<double> l;
-        l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.peloton_resistance);
-        }
-        return l;
-    }
+    // the -test-tiles benchmark: runs update() on the connected device and counts the tile notifications
+    int benchmarkUpdate(int refreshes);
 
     QList<double> preview_workout_watt() {
         QList<double> l;
-        if (!previewTrainProgram)
-            return l;
-        QTime d = previewTrainProgram->duration();
-        l.reserve((d.hour() * 3600) + (d.minute() * 60) + d.second() + 1);
-        foreach (trainrow r, previewTrainProgram->loadedRows) {
-            for (int i = 0; i < (r.duration.hour() * 3600) + (r.duration.minute() * 60) + r.duration.second(); i++) {
-                l.append(r.power);
-            }
+        l.reserve(preview_workout_points() + 1);
+        // the profile of the library has a point every step seconds
+        for (int i = 0; i < preview_workout_points(); i++) {
+            l.append(previewEntry.power.value(i / previewEntry.step, -1));
         }
         return l;
     }
 
-    QString previewWorkoutDescription() {
-        if (previewTrainProgram) {
-            return previewTrainProgram->description;
-        }
-        return "";
-    }
+    QString previewWorkoutDescription() { return previewEntry.description; }
 
-    QString previewWorkoutTags() {
-        if (previewTrainProgram) {
-            return previewTrainProgram->tags;
-        }
-        return "";
-    }
+    QString previewWorkoutTags() { return previewEntry.tags; }
+
+    QString previewWorkoutSummary() { return previewEntry.summary(); }
 
     bool currentCoordinateValid() {
         if (bluetoothManager && bluetoothManager->device()) {
@@ -480,7 +463,11 @@ class homeform : public QObject {
     bluetooth *bluetoothManager;
     QQmlApplicationEngine *engine;
     trainprogram *trainProgram = nullptr;
-    trainprogram *previewTrainProgram = nullptr;
+    workoutlibrary *workoutLibrary = nullptr;
+    workoutlibrary::entry previewEntry;
+    // the folders of the workouts and of the routes indexed by workoutLibrary
+    static QStringList workoutFolders();
+    heartratezonecontroller heartZoneController;
     QString backupFitFileName =
         QStringLiteral("QZ-backup-") +
         QDateTime::currentDateTime().toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
@@ -570,8 +557,57 @@ class homeform : public QObject {
     DataObject *groundContactMS;
     DataObject *verticalOscillationMM;
 
+    QList<TileLayoutEntry> tileLayoutEntries(bluetoothdevice::BLUETOOTH_TYPE type, bool pelotoncadence);
+    void buildTileLayout(bluetoothdevice::BLUETOOTH_TYPE type);
+    QList<QPair<int, DataObject *>> tileLayout;
+    bluetoothdevice::BLUETOOTH_TYPE tileLayoutType = bluetoothdevice::UNKNOWN;
+    bool tileLayoutValid = false;
+
+    QList<TileBinding> tileBindings;
+    QSet<DataObject *> visibleTiles;
+    void setupTileBindings();
+    void updateTileBindings(bool miles);
+    bool tileVisible(DataObject *tile) const { return visibleTiles.contains(tile); }
+
+    // the settings that update() reads on every refresh, cached by loadUpdateSettings() at startup and when the
+    // settings change
+    struct {
+        bool topBarEnabled;
+        bool miles;
+        double ftp;
+        bool power5s;
+        uint8_t pidHeartZone; // 0 when disabled
+        bool fanfitEnabled;
+        QString fanfitMode;
+        bool pelotonCadence;
+        double eliteRizerGain;
+        double resistanceGain;
+        double resistanceOffset;
+        bool pelotonResistanceColor;
+        bool cadenceColor;
+        double heartRateZone[4];
+        double heartRateMax;
+        uint32_t pidSampleTime;
+        QString pidActuator;
+        double pidKp;
+        double pidKi;
+        double pidKd;
+        bool trainProgramRandom;
+        bool antCadence;
+        bool ttsEnabled;
+        bool ttsDescription;
+        int ttsSummarySec;
+    } updateSettings;
+    void loadUpdateSettings();
+    double heartZone(double heart) const;
+    void updateHeartZoneController();
+
+    workoutchartmodel *chartModel;
+
     QTimer *timer;
+    QTimer *sampleTimer;
     QTimer *backupTimer;
+    QTimer settingsChangedTimer;
 
     QString strava_code;
     QOAuth2AuthorizationCodeFlow *strava_connect();
@@ -587,6 +623,7 @@ class homeform : public QObject {
     int16_t fanOverride = 0;
 
     void update();
+    void sample();
     double heartRateMax();
     void backup();
     bool getDevice();
@@ -594,7 +631,7 @@ class homeform : public QObject {
     void Start_inner(bool send_event_to_device);
 
     QTextToSpeech m_speech;
-    int tts_summary_count = 0;
+    int tts_summary_elapsed_ms = 0;
     
 #if defined(Q_OS_WIN) || (defined(Q_OS_MAC) && !defined(Q_OS_IOS))
     QTimer tLicense;
@@ -613,6 +650,8 @@ class homeform : public QObject {
     void deleteSettings(const QUrl &filename);
     void saveProfile(QString profilename);
     void restart();
+    // the settings were written (QML pages, profiles, templates): refresh what is cached from them
+    void settingsChanged();
 
   private slots:
     void Start();
@@ -701,6 +740,7 @@ class homeform : public QObject {
     void previewWorkoutPointsChanged(int value);
     void previewWorkoutDescriptionChanged(QString value);
     void previewWorkoutTagsChanged(QString value);
+    void previewWorkoutSummaryChanged(QString value);
 
     void workoutEventStateChanged(bluetoothdevice::WORKOUT_EVENT_STATE state);
 };
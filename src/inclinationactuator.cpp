@@ -0,0 +1,121 @@
+#include "inclinationactuator.h"
+#include <QDebug>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QStringList>
+#include <QtMath>
+
+static QString settingsKey(const QString &deviceId) {
+    QString id = deviceId;
+    id.remove(QRegularExpression(QStringLiteral("[^0-9A-Za-z]")));
+    return QStringLiteral("inclination_actuator_") + id;
+}
+
+void inclinationactuator::clear() {
+    m_deadTime = defaultDeadTime;
+    m_slewRate = defaultSlewRate;
+    moves = 0;
+    unsaved = 0;
+    pending = false;
+    moving = false;
+    hasValue = false;
+}
+
+void inclinationactuator::load(const QString &deviceId) {
+    if (deviceId == id)
+        return;
+    save();
+    clear();
+    id = deviceId;
+    if (id.isEmpty())
+        return;
+    QSettings settings;
+    QStringList values = settings.value(settingsKey(id)).toString().split(QLatin1Char(';'));
+    if (values.length() != 3)
+        return;
+    m_deadTime = values.at(0).toDouble();
+    m_slewRate = values.at(1).toDouble();
+    moves = values.at(2).toInt();
+    qDebug() << QStringLiteral("inclination actuator loaded") << id << m_deadTime << m_slewRate << moves;
+}
+
+void inclinationactuator::save() {
+    if (id.isEmpty() || unsaved == 0)
+        return;
+    QSettings settings;
+    settings.setValue(settingsKey(id), QStringLiteral("%1;%2;%3")
+                                           .arg(m_deadTime, 0, 'g', 6)
+                                           .arg(m_slewRate, 0, 'g', 6)
+                                           .arg(moves));
+    unsaved = 0;
+}
+
+void inclinationactuator::command(double inclination, qint64 ms) {
+    // the routes update the target every second: while the device is still going the same way it is the same
+    // movement, the dead time is measured from the first command
+    if (pending && (inclination - startValue) * (target - startValue) > 0) {
+        target = inclination;
+        return;
+    }
+    target = inclination;
+    pending = hasValue && qAbs(inclination - lastValue) >= minMovement;
+    moving = false;
+    startValue = lastValue;
+    commandTime = ms;
+}
+
+void inclinationactuator::feedback(double inclination, qint64 ms) {
+    if (!hasValue) {
+        hasValue = true;
+        lastValue = inclination;
+        lastChangeTime = ms;
+        lastSampleTime = ms;
+        return;
+    }
+
+    bool changed = qAbs(inclination - lastValue) >= 0.05;
+    if (pending) {
+        double elapsed = (ms - commandTime) / 1000.0;
+        if (!moving) {
+            if ((inclination - startValue) * (target - startValue) > 0 && qAbs(inclination - startValue) >= 0.1) {
+                // the movement started between the previous sample and this one
+                moving = true;
+                measuredDeadTime = ((qMax(lastSampleTime, commandTime) + ms) / 2 - commandTime) / 1000.0;
+            } else if (elapsed > 15) {
+                // the device didn't move: at the limit of the range or the command was ignored
+                pending = false;
+            }
+        } else if (qAbs(inclination - target) < 0.15 || (!changed && ms - lastChangeTime > 3000)) {
+            double end = (qAbs(inclination - target) < 0.15 && changed) ? ms : lastChangeTime;
+            double travel = qAbs((changed ? inclination : lastValue) - startValue);
+            double duration = (end - commandTime) / 1000.0 - measuredDeadTime;
+            if (travel >= minMovement && duration > 0.2)
+                learn(measuredDeadTime, travel / duration);
+            pending = false;
+        } else if (elapsed > 60) {
+            pending = false;
+        }
+    }
+
+    if (changed) {
+        lastValue = inclination;
+        lastChangeTime = ms;
+    }
+    lastSampleTime = ms;
+}
+
+void inclinationactuator::learn(double deadTime, double slewRate) {
+    // the first movements replace the defaults, then a moving average follows the device
+    double alpha = moves < 5 ? 1.0 / (moves + 1) : 0.2;
+    m_deadTime += alpha * (qBound(0.0, deadTime, 10.0) - m_deadTime);
+    m_slewRate += alpha * (qBound(0.05, slewRate, 5.0) - m_slewRate);
+    moves++;
+    qDebug() << QStringLiteral("inclination actuator") << deadTime << slewRate << QStringLiteral("model")
+             << m_deadTime << m_slewRate << moves;
+    if (++unsaved >= saveEvery)
+        save();
+}
+
+double inclinationactuator::leadTime(double from, double to) const {
+    return m_deadTime + qAbs(to - from) / m_slewRate;
+}
@@ -0,0 +1,70 @@
+#ifndef INCLINATIONACTUATOR_H
+#define INCLINATIONACTUATOR_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @brief Model of the inclination motor of a device: the dead time between a command and the first movement and the
+ * slew rate while moving, learned comparing the inclination commands with the Inclination read back from the device.
+ * The model is stored in the settings by device address.
+ */
+class inclinationactuator {
+  public:
+    ~inclinationactuator() { save(); }
+
+    /**
+     * @brief Load the model of a device, saving the one of the previous device.
+     */
+    void load(const QString &deviceId);
+    void save();
+    const QString &deviceId() const { return id; }
+    void clear();
+
+    /**
+     * @brief A new inclination has been requested to the device.
+     * @param ms A monotonic time in milliseconds
+     */
+    void command(double inclination, qint64 ms);
+    /**
+     * @brief The inclination read from the device, at least once per second while a command is pending.
+     * @param ms A monotonic time in milliseconds
+     */
+    void feedback(double inclination, qint64 ms);
+
+    double deadTime() const { return m_deadTime; } // seconds
+    double slewRate() const { return m_slewRate; } // % per second
+    int moveCount() const { return moves; }
+    /**
+     * @brief The seconds the device needs to move from an inclination to another.
+     */
+    double leadTime(double from, double to) const;
+
+  private:
+    static constexpr double defaultDeadTime = 1.0;
+    static constexpr double defaultSlewRate = 0.5;
+    // smaller movements are too close to the resolution of the devices to be measured
+    static constexpr double minMovement = 0.5;
+    static constexpr int saveEvery = 10;
+
+    void learn(double deadTime, double slewRate);
+
+    QString id;
+    double m_deadTime = defaultDeadTime;
+    double m_slewRate = defaultSlewRate;
+    int moves = 0;
+    int unsaved = 0;
+
+    bool pending = false;
+    bool moving = false;
+    double target = 0;
+    double startValue = 0;
+    qint64 commandTime = 0;
+    double measuredDeadTime = 0;
+    double lastValue = 0;
+    qint64 lastChangeTime = 0;
+    qint64 lastSampleTime = 0;
+    bool hasValue = false;
+};
+
+#endif // INCLINATIONACTUATOR_H
@@ -32,7 +32,9 @@ var ftpZones = [];
 var maxHeartRate = 190;
 var heartZones = [];
 
-function process_arr(arr) {
+// with "step" > 1 the samples are decimated by the app: a sample stands for the samples up to the next one, so the
+// distribution is weighted on the "count" samples of the session and not on the ones received
+function process_arr(arr, step = 1, count = arr.length) {
     let watts = [];
     let reqpower = [];
     let reqcadence = [];
@@ -69,7 +71,13 @@ function process_arr(arr) {
     distributionPowerZones[5] = 0;
     distributionPowerZones[6] = 0;
 
-    for (let el of arr) {
+    let sampleIndex = function(i) {
+        // the last sample of the session is always sent, even when it is not on the step
+        return Math.min(i * step, count - 1);
+    };
+
+    for (let [i, el] of arr.entries()) {
+        let weight = i < arr.length - 1 ? sampleIndex(i + 1) - sampleIndex(i) : 1;
         let wattel = {};
         let reqpowerel = {};
         let reqcadenceel = {};
@@ -94,19 +102,19 @@ function process_arr(arr) {
         wattel.y = el.watts;
         watts.push(wattel);
         if(el.watts < ftpZones[0])
-            distributionPowerZones[0]++;
+            distributionPowerZones[0] += weight;
         else if(el.watts < ftpZones[1])
-            distributionPowerZones[1]++;
+            distributionPowerZones[1] += weight;
         else if(el.watts < ftpZones[2])
-            distributionPowerZones[2]++;
+            distributionPowerZones[2] += weight;
         else if(el.watts < ftpZones[3])
-            distributionPowerZones[3]++;
+            distributionPowerZones[3] += weight;
         else if(el.watts < ftpZones[4])
-            distributionPowerZones[4]++;
+            distributionPowerZones[4] += weight;
         else if(el.watts < ftpZones[5])
-            distributionPowerZones[5]++;
+            distributionPowerZones[5] += weight;
         else
-            distributionPowerZones[6]++;
+            distributionPowerZones[6] += weight;
         reqpowerel.x = time;
         reqpowerel.y = el.req_power;
         reqpower.push(reqpowerel);
@@ -1134,15 +1142,22 @@ function dochart_init() {
     el.enqueue().then(onSettingsOK).catch(function(err) {
             console.error('Error is ' + err);
     })
+    // overview of the whole session: the app decimates the samples, so even long rides load instantly
     el = new MainWSQueueElement({
-        msg: 'getsessionarray'
+        msg: 'getsessionhistory',
+        content: {
+            since: 0,
+            maxpoints: 3600
+        }
     }, function(msg) {
-        if (msg.msg === 'R_getsessionarray') {
+        if (msg.msg === 'R_getsessionhistory') {
             return msg.content;
         }
         return null;
     }, 15000, 3);
-    el.enqueue().then(process_arr).catch(function(err) {
+    el.enqueue().then(function(content) {
+        process_arr(content.samples, content.step, content.seq - content.from);
+    }).catch(function(err) {
         console.error('Error is ' + err);
     });
 }
@@ -11,16 +11,29 @@
 
 #include "bluetooth.h"
 #include "domyostreadmill.h"
+#include "heartratesimulator.h"
 #include "homeform.h"
 #include "mainwindow.h"
 #include "qfit.h"
+#include "templateinfosenderbuilder.h"
 #include "virtualtreadmill.h"
+#include "workoutsnapshot.h"
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
 #include <QGuiApplication>
+#include <QJsonDocument>
 #include <QOperatingSystemVersion>
 #include <QQmlApplicationEngine>
 #include <QSettings>
 #include <QStandardPaths>
+#ifdef Q_HTTPSERVER
+#include "webserverinfosender.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtWebSockets/QWebSocket>
+#endif
 #ifdef CHARTJS
 #include <QtWebView/QtWebView>
 #endif
@@ -48,6 +61,12 @@ bool onlyVirtualTreadmill = false;
 bool testPeloton = false;
 bool testHomeFitnessBudy = false;
 bool testPowerZonePack = false;
+bool testHRZone = false;
+bool testTiles = false;
+bool testTemplates = false;
+bool testFetch = false;
+bool testErgTable = false;
+bool testErg = false;
 QString peloton_username = "";
 QString peloton_password = "";
 QString pzp_username = "";
@@ -79,6 +98,22 @@ QString logfilename = QStringLiteral("debug-") +
                       QStringLiteral(".log");
 static const QtMessageHandler QT_DEFAULT_MESSAGE_HANDLER = qInstallMessageHandler(0);
 
+// a template sender keeping the last message, for -test-templates
+class benchtemplatesender : public TemplateInfoSender {
+  public:
+    benchtemplatesender() : TemplateInfoSender(QStringLiteral("bench")) {}
+    using TemplateInfoSender::init;
+    bool isRunning() const override { return true; }
+    bool send(const QString &data) override {
+        message = data;
+        return true;
+    }
+    QString message;
+
+  protected:
+    bool init() override { return true; }
+};
+
 QCoreApplication *createApplication(int &argc, char *argv[]) {
 
     QSettings settings;
@@ -137,6 +172,18 @@ QCoreApplication *createApplication(int &argc, char *argv[]) {
             testHomeFitnessBudy = true;
         if (!qstrcmp(argv[i], "-test-pzp"))
             testPowerZonePack = true;
+        if (!qstrcmp(argv[i], "-test-hr-zone"))
+            testHRZone = true;
+        if (!qstrcmp(argv[i], "-test-tiles"))
+            testTiles = true;
+        if (!qstrcmp(argv[i], "-test-templates"))
+            testTemplates = true;
+        if (!qstrcmp(argv[i], "-test-fetch"))
+            testFetch = true;
+        if (!qstrcmp(argv[i], "-test-erg-table"))
+            testErgTable = true;
+        if (!qstrcmp(argv[i], "-test-erg"))
+            testErg = true;
         if (!qstrcmp(argv[i], "-train")) {
 
             trainProgram = argv[++i];
@@ -288,7 +335,8 @@ int main(int argc, char *argv[]) {
 
 #ifdef Q_OS_LINUX
 #ifndef Q_OS_ANDROID
-    if (getuid() && !testPeloton && !testHomeFitnessBudy && !testPowerZonePack) {
+    if (getuid() && !testPeloton && !testHomeFitnessBudy && !testPowerZonePack && !testHRZone && !testTiles &&
+        !testTemplates && !testFetch && !testErgTable && !testErg) {
 
         printf("Runme as root!\n");
         return -1;
@@ -428,6 +476,384 @@ int main(int argc, char *argv[]) {
                 }
             });
             return app->exec();
+        } else if (testHRZone) {
+            // runs the heart zone controller, with the gains of the settings, against the heart rate model for an
+            // hour in every zone and with every actuator
+            const double thresholds[4] = {
+                settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble(),
+                settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble(),
+                settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble(),
+                settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble()};
+            struct {
+                const char *name;
+                heartratezonecontroller::ACTUATOR actuator;
+                double step, min, max, start;
+                uint32_t creep;
+            } scenarios[] = {{"treadmill speed", heartratezonecontroller::SPEED, 0.2, 1, 30, 5, 6},
+                             {"treadmill inclination", heartratezonecontroller::INCLINATION, 0.5, 0, 15, 0, 0},
+                             {"bike resistance", heartratezonecontroller::RESISTANCE, 1, 1, 32, 5, 0},
+                             {"bike power", heartratezonecontroller::POWER, 10, 50, 1000, 100, 0}};
+            int ret = 0;
+            for (const auto &sc : scenarios) {
+                for (int zone = 2; zone <= 4; zone++) {
+                    heartratezonecontroller c;
+                    c.setGains(
+                        settings.value(QZSettings::hr_zone_pid_kp, QZSettings::default_hr_zone_pid_kp).toDouble(),
+                        settings.value(QZSettings::hr_zone_pid_ki, QZSettings::default_hr_zone_pid_ki).toDouble(),
+                        settings.value(QZSettings::hr_zone_pid_kd, QZSettings::default_hr_zone_pid_kd).toDouble());
+                    c.setSampleTime(
+                        settings.value(QZSettings::hr_zone_pid_sample_time, QZSettings::default_hr_zone_pid_sample_time)
+                            .toUInt());
+                    c.setActuator(sc.actuator, sc.step, sc.min, sc.max, sc.creep);
+                    heartratesimulator sim;
+                    heartratesimulator::result r = sim.run(c, sc.actuator, sc.start, zone, thresholds, 3600);
+                    qDebug() << sc.name << "zone" << zone << "in zone" << r.inZone << "heart" << r.finalHeart
+                             << "actuator" << r.finalActuator << "changes" << r.actuatorChanges;
+                    if (r.inZone < 0.6)
+                        ret = 2;
+                }
+            }
+            return ret;
+        } else if (testTemplates) {
+            // the cost of an update of the templates that ship with the app, compiled once against evaluated on
+            // every update like before, and the messages of the two ways, that must be the same: the tcp client
+            // templates and the script of the built-in web server (inner_templates), that is also timed on the path
+            // it really takes, the workout message of the snapshot without the JS engine
+            QJSEngine engine;
+            engine.installExtensions(QJSEngine::AllExtensions);
+            QJSValue workout = engine.newObject();
+            workout.setProperty(QStringLiteral("deviceId"), QStringLiteral("00:11:22:33:44:55"));
+            workout.setProperty(QStringLiteral("deviceName"), QStringLiteral("bench"));
+            workout.setProperty(QStringLiteral("deviceType"), (int)bluetoothdevice::BIKE);
+            workout.setProperty(QStringLiteral("BIKE_TYPE"), (int)bluetoothdevice::BIKE);
+            workout.setProperty(QStringLiteral("elapsed_h"), 0);
+            workout.setProperty(QStringLiteral("elapsed_m"), 12);
+            workout.setProperty(QStringLiteral("elapsed_s"), 5);
+            workout.setProperty(QStringLiteral("distance"), 5.25);
+            workout.setProperty(QStringLiteral("speed"), 27.3);
+            workout.setProperty(QStringLiteral("watts"), 210.0);
+            workout.setProperty(QStringLiteral("cadence"), 85.0);
+            workout.setProperty(QStringLiteral("heart"), 0);
+            workout.setProperty(QStringLiteral("calories"), 250.5);
+            engine.globalObject().setProperty(QStringLiteral("workout"), workout);
+
+            const int updates = 10000;
+            int ret = 0;
+            QList<QPair<QString, QString>> scripts;
+            for (const QString &path :
+                 {QStringLiteral(":/templates/qz-TcpClient.qzt"), QStringLiteral(":/templates/vlc-TcpClient.qzt")}) {
+                QFile f(path);
+                if (!f.open(QFile::ReadOnly | QFile::Text)) {
+                    qDebug() << path << "not found";
+                    ret = 2;
+                    continue;
+                }
+                scripts.append(qMakePair(path, QTextStream(&f).readAll()));
+            }
+            scripts.append(qMakePair(QStringLiteral("inner_templates"), TEMPLATE_WORKOUT_MESSAGE_SCRIPT));
+            for (const auto &s : qAsConst(scripts)) {
+                const QString &path = s.first;
+                const QString &script = s.second;
+                benchtemplatesender sender;
+                sender.init(script);
+                QElapsedTimer t;
+                t.start();
+                for (int i = 0; i < updates; i++)
+                    sender.update(&engine);
+                double compiled = (double)t.nsecsElapsed() / updates / 1000.0;
+                QString evaluated;
+                t.restart();
+                for (int i = 0; i < updates; i++)
+                    evaluated = engine.evaluate(script).toString();
+                double evaluation = (double)t.nsecsElapsed() / updates / 1000.0;
+                bool same = !sender.message.isEmpty() && sender.message == evaluated;
+                qDebug() << path << "compiled" << compiled << "us evaluated" << evaluation << "us"
+                         << (same ? "same message" : "different message");
+                if (!same)
+                    ret = 2;
+            }
+
+            // the built-in web server: the workout of a bike captured and sent on every update, through the script
+            // and as the message of the snapshot, that must have the same content
+            fakebike device(true, true, true);
+            WorkoutSnapshot snapshot;
+            workout = engine.newObject();
+            engine.globalObject().setProperty(QStringLiteral("workout"), workout);
+            benchtemplatesender scripted;
+            scripted.init(TEMPLATE_WORKOUT_MESSAGE_SCRIPT);
+            QElapsedTimer t;
+            t.start();
+            for (int i = 0; i < updates; i++) {
+                snapshot.capture(&device, QString(), QString(), QString(), QString());
+                snapshot.fillJSValue(workout);
+                scripted.update(&engine);
+            }
+            double script = (double)t.nsecsElapsed() / updates / 1000.0;
+            benchtemplatesender direct;
+            t.restart();
+            for (int i = 0; i < updates; i++) {
+                snapshot.capture(&device, QString(), QString(), QString(), QString());
+                direct.sendWorkout(snapshot);
+            }
+            double message = (double)t.nsecsElapsed() / updates / 1000.0;
+            bool same = !direct.message.isEmpty() && QJsonDocument::fromJson(scripted.message.toUtf8()) ==
+                                                          QJsonDocument::fromJson(direct.message.toUtf8());
+            qDebug() << "inner_templates script" << script << "us snapshot message" << message << "us"
+                     << (same ? "same message" : "different message");
+            if (!same)
+                ret = 2;
+            return ret;
+        } else if (testFetch) {
+#ifdef Q_HTTPSERVER
+            // the fetch proxy of the template web server against a local stand-in http server answering after 200ms:
+            // the identical requests in flight reach the server once, the cacheable responses are then served from
+            // the cache and the no-store ones are not, at most 4 requests run at the same time for a host, and a
+            // requester closing before its response doesn't break the others
+            auto waitFor = [](const std::function<bool()> &done) {
+                QEventLoop loop;
+                QTimer poll;
+                QObject::connect(&poll, &QTimer::timeout, [&]() {
+                    if (done())
+                        loop.quit();
+                });
+                poll.start(10);
+                QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+                loop.exec();
+                return done();
+            };
+
+            QHash<QTcpSocket *, QByteArray> received;
+            QHash<QString, int> hits;
+            int active = 0;
+            int maxActive = 0;
+            QTcpServer origin;
+            QObject::connect(&origin, &QTcpServer::newConnection, [&]() {
+                while (QTcpSocket *s = origin.nextPendingConnection()) {
+                    QObject::connect(s, &QTcpSocket::disconnected, [&, s]() {
+                        received.remove(s);
+                        s->deleteLater();
+                    });
+                    QObject::connect(s, &QTcpSocket::readyRead, [&, s]() {
+                        QByteArray &in = received[s];
+                        in += s->readAll();
+                        int end;
+                        while ((end = in.indexOf("\r\n\r\n")) >= 0) {
+                            QString path = QString::fromLatin1(in.left(in.indexOf("\r\n")).split(' ').value(1));
+                            in.remove(0, end + 4);
+                            hits[path]++;
+                            maxActive = qMax(maxActive, ++active);
+                            QTimer::singleShot(200, s, [&, s, path]() {
+                                active--;
+                                QByteArray body = path.toUtf8();
+                                QByteArray cache =
+                                    path.startsWith(QStringLiteral("/nostore")) ? "no-store" : "max-age=60";
+                                s->write("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nCache-Control: " + cache +
+                                         "\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body);
+                            });
+                        }
+                    });
+                }
+            });
+            if (!origin.listen(QHostAddress::LocalHost)) {
+                qDebug() << "the stand-in server can't listen";
+                return 2;
+            }
+
+            const QString id = QStringLiteral("test_fetch");
+            settings.setValue(QStringLiteral("template_") + id + QStringLiteral("_folders"),
+                              QStringList() << QDir::tempPath());
+            settings.setValue(QStringLiteral("template_") + id + QStringLiteral("_port"), 0);
+            WebServerInfoSender proxy(id);
+            static_cast<TemplateInfoSender &>(proxy).init(QString());
+            int port = settings.value(QStringLiteral("template_") + id + QStringLiteral("_port")).toInt();
+            settings.remove(QStringLiteral("template_") + id + QStringLiteral("_folders"));
+            settings.remove(QStringLiteral("template_") + id + QStringLiteral("_port"));
+            if (!proxy.isRunning()) {
+                qDebug() << "the template web server can't listen";
+                return 2;
+            }
+
+            QUrl fetcherUrl(QStringLiteral("ws://127.0.0.1:%1/fetcher").arg(port));
+            QHash<QString, QString> responses;
+            QWebSocket client;
+            QObject::connect(&client, &QWebSocket::textMessageReceived, [&](const QString &message) {
+                QJsonObject obj = QJsonDocument::fromJson(message.toUtf8()).object();
+                responses.insert(obj[QStringLiteral("req")].toString(), obj[QStringLiteral("body")].toString());
+            });
+            client.open(fetcherUrl);
+            if (!waitFor([&]() { return client.state() == QAbstractSocket::ConnectedState; })) {
+                qDebug() << "the fetcher socket can't connect";
+                return 2;
+            }
+            auto fetch = [&](QWebSocket &ws, const QString &req, const QString &path) {
+                QJsonObject obj;
+                obj[QStringLiteral("req")] = req;
+                obj[QStringLiteral("url")] = QStringLiteral("http://127.0.0.1:%1").arg(origin.serverPort()) + path;
+                ws.sendTextMessage(QString::fromUtf8(QJsonDocument(obj).toJson(QJsonDocument::Compact)));
+            };
+            auto answered = [&](const QStringList &reqs, const QString &path) {
+                return waitFor([&]() {
+                    for (const QString &req : reqs)
+                        if (responses.value(req) != path)
+                            return false;
+                    return true;
+                });
+            };
+
+            int ret = 0;
+            auto check = [&](const char *name, bool ok) {
+                qDebug() << name << (ok ? "ok" : "FAILED");
+                if (!ok)
+                    ret = 2;
+            };
+
+            QStringList reqs;
+            for (int i = 0; i < 5; i++) {
+                reqs << QStringLiteral("coalesced%1").arg(i);
+                fetch(client, reqs.last(), QStringLiteral("/tile"));
+            }
+            check("coalescing", answered(reqs, QStringLiteral("/tile")) && hits.value(QStringLiteral("/tile")) == 1);
+
+            fetch(client, QStringLiteral("cached"), QStringLiteral("/tile"));
+            check("cache", answered({QStringLiteral("cached")}, QStringLiteral("/tile")) &&
+                               hits.value(QStringLiteral("/tile")) == 1);
+
+            fetch(client, QStringLiteral("nostore0"), QStringLiteral("/nostore"));
+            bool first = answered({QStringLiteral("nostore0")}, QStringLiteral("/nostore"));
+            fetch(client, QStringLiteral("nostore1"), QStringLiteral("/nostore"));
+            check("no-store", first && answered({QStringLiteral("nostore1")}, QStringLiteral("/nostore")) &&
+                                  hits.value(QStringLiteral("/nostore")) == 2);
+
+            // distinct URLs, so they are not coalesced
+            maxActive = 0;
+            for (int i = 0; i < 10; i++)
+                fetch(client, QStringLiteral("host%1").arg(i), QStringLiteral("/host/%1").arg(i));
+            bool all = true;
+            for (int i = 0; i < 10; i++)
+                all = answered({QStringLiteral("host%1").arg(i)}, QStringLiteral("/host/%1").arg(i)) && all;
+            check("per host limit", all && maxActive > 0 && maxActive <= 4);
+
+            QWebSocket *gone = new QWebSocket();
+            gone->open(fetcherUrl);
+            waitFor([&]() { return gone->state() == QAbstractSocket::ConnectedState; });
+            fetch(*gone, QStringLiteral("gone"), QStringLiteral("/gone"));
+            fetch(client, QStringLiteral("stays"), QStringLiteral("/gone"));
+            waitFor([&]() { return hits.value(QStringLiteral("/gone")) == 1; });
+            delete gone;
+            check("requester gone", answered({QStringLiteral("stays")}, QStringLiteral("/gone")));
+            return ret;
+#else
+            qDebug() << "built without the template web server";
+            return 2;
+#endif
+        } else if (testErgTable) {
+            // the levels of the ERG table against the linear scan that the bikes did before, with the power model of
+            // every bike, on a grid of integer and fractional cadences and of powers, with and without a calibration
+            struct {
+                const char *name;
+                ergtable::wattsFunction watts;
+                resistance_t maxResistance;
+                // last level of the scan
+                resistance_t last;
+            } models[] = {
+                {"domyos", [](double c, resistance_t r) { return (double)domyosbike::wattsFromResistance(r, c); }, 15,
+                 15},
+                {"echelon connect sport",
+                 [](double c, resistance_t r) { return (double)echelonconnectsport::wattsFromResistance(r, c); }, 32,
+                 32},
+                {"echelon rower",
+                 [](double c, resistance_t r) { return (double)echelonrower::wattsFromResistance(r, c); }, 32, 31},
+                {"mcf", [](double c, resistance_t r) { return (double)mcfbike::wattsFromResistance(r, c); }, 14, 14},
+                {"pafers", [](double c, resistance_t r) { return (double)pafersbike::wattsFromResistance(r, c); }, 24,
+                 24},
+                {"proform", [](double c, resistance_t r) { return (double)proformbike::wattsFromResistance(r, c); }, 16,
+                 16},
+                {"proform wifi",
+                 [](double c, resistance_t r) { return (double)proformwifibike::wattsFromResistance(r, c); }, 100,
+                 100}};
+            // gain and offset of the calibration
+            const double calibrations[][2] = {{1.0, 0.0}, {0.9, 12.0}};
+            const int powers = 301;
+            int ret = 0;
+            for (const auto &m : models) {
+                ergtable table;
+                QElapsedTimer t;
+                t.start();
+                table.build(1, m.maxResistance, m.watts);
+                qint64 buildNs = t.nsecsElapsed();
+                qint64 scanNs = 0;
+                qint64 tableNs = 0;
+                int lookups = 0;
+                int mismatches = 0;
+                QVector<int> scan(powers);
+                QVector<int> levels(powers);
+                for (const auto &calibration : calibrations) {
+                    // 1.3 rpm steps up to 220 rpm, over the 200 rpm of the table
+                    for (int c = 0; c <= 2200; c += 13) {
+                        double cadence = c / 10.0;
+                        auto level = [&](resistance_t r) {
+                            return m.watts(cadence, r) * calibration[0] + calibration[1];
+                        };
+                        t.restart();
+                        for (int p = 0; p < powers; p++) {
+                            scan[p] = -1;
+                            for (resistance_t i = 1; i < m.last; i++) {
+                                if (level(i) <= p * 5 && level(i + 1) >= p * 5) {
+                                    scan[p] = i;
+                                    break;
+                                }
+                            }
+                        }
+                        scanNs += t.nsecsElapsed();
+                        t.restart();
+                        for (int p = 0; p < powers; p++)
+                            levels[p] = table.resistanceFromPower(p * 5, cadence, 1, m.last, calibration[0],
+                                                                  calibration[1]);
+                        tableNs += t.nsecsElapsed();
+                        for (int p = 0; p < powers; p++) {
+                            if (levels.at(p) != scan.at(p) && mismatches++ < 5)
+                                qDebug() << m.name << "cadence" << cadence << "power" << p * 5 << "gain"
+                                         << calibration[0] << "scan" << scan.at(p) << "table" << levels.at(p);
+                        }
+                        lookups += powers;
+                    }
+                }
+                qDebug() << m.name << "table built in" << buildNs / 1000 << "us," << lookups << "lookups: scan"
+                         << scanNs / lookups << "ns table" << tableNs / lookups << "ns," << mismatches << "mismatches";
+                if (mismatches)
+                    ret = 2;
+            }
+            return ret;
+        } else if (testErg) {
+            // the closed loop ERG, with the settings, against the bike of fakebike_erg_simulation: a step of the
+            // target every 90 seconds, the loop updated every second like bike::ergUpdate and the bike every 200ms.
+            // The overshoot includes the quantization of the levels, the settling time the hold after a step and
+            // the lag of the power meter.
+            double settlingTime =
+                settings.value(QZSettings::zwift_erg_settling_time, QZSettings::default_zwift_erg_settling_time)
+                    .toDouble();
+            ergcontroller c;
+            c.setFeedForward([](double power) { return (double)((uint16_t)power / 10); });
+            c.setLimits(0, 100);
+            c.setSettlingTime(settlingTime);
+            c.setMaxRate(
+                settings.value(QZSettings::zwift_erg_max_rate, QZSettings::default_zwift_erg_max_rate).toDouble());
+            double watts = 0;
+            resistance_t resistance = 0;
+            int ret = 0;
+            for (double target : {150.0, 250.0, 120.0, 300.0, 200.0}) {
+                c.setTarget(target);
+                for (int tick = 1; tick <= 90 * 5; tick++) {
+                    watts = fakebike::ergSimulationPower(watts, resistance);
+                    if (tick % 5 == 0)
+                        resistance = (resistance_t)qRound(c.update(watts, 85, 1.0));
+                }
+                qDebug() << "target" << target << "overshoot" << c.stepOvershoot() << "settling time"
+                         << c.stepSettlingTime() << "power" << watts << "resistance" << resistance;
+                if (c.stepOvershoot() > 0.2 || c.stepSettlingTime() > settlingTime + 5.0)
+                    ret = 2;
+            }
+            return ret;
         }
     }
 #endif
@@ -540,6 +966,22 @@ int main(int argc, char *argv[]) {
         QObject::connect(app.data(), &QCoreApplication::aboutToQuit, h,
                          &homeform::aboutToQuit); // NOTE: clazy-unneeded-cast
 
+        if (testTiles) {
+            // the cost of a refresh of the ui (homeform::update) with the tiles of the settings on a fake bike, and
+            // the notifications sent to qml: the values don't change between the refreshes, so there must not be
+            // one for every refresh
+            bl.connectFakeDevice(bluetoothdevice::BIKE);
+            h->benchmarkUpdate(1);
+
+            const int refreshes = 10000;
+            QElapsedTimer t;
+            t.start();
+            int notifications = h->benchmarkUpdate(refreshes);
+            qDebug() << "ui refresh" << (double)t.nsecsElapsed() / refreshes / 1000.0 << "us per refresh"
+                     << "notifications" << notifications;
+            return notifications >= refreshes ? 2 : 0;
+        }
+
         {
 #ifdef Q_OS_ANDROID
             KeepAwakeHelper helper;
@@ -2,6 +2,7 @@
 #include "qdebugfixup.h"
 #include <QSettings>
 #include "qzsettings.h"
+#include "routesimulator.h"
 
 #ifdef TEST
 static uint32_t random_value_uint32 = 0;
@@ -181,74 +182,17 @@ void metric::clearLap(bool accumulator) {
 
 void metric::setLap(bool accumulator) { clearLap(accumulator); }
 
+// the settings are read on every call, see routesimulator to evaluate many points
 double metric::calculateMaxSpeedFromPower(double power, double inclination) {
-    QSettings settings;
-    double rolling_resistance = settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double aero = 0.22691607640851885;
-    double hw = 0; // wind speed
-    double tr = twt * ((inclination / 100.0) + rolling_resistance);
-    double tran = 0.95;
-    double p = power;
-    double vel = 20;        // Initial guess
-    const uint8_t MAX = 10; // maximum iterations
-    double TOL = 0.05;      // tolerance
-    for (int i = 1; i < MAX; i++) {
-        double tv = vel + hw;
-        double aeroEff = (tv > 0.0) ? aero : -aero;           // wind in face, must reverse effect
-        double f = vel * (aeroEff * tv * tv + tr) - tran * p; // the function
-        double fp = aeroEff * (3.0 * vel + hw) * tv + tr;     // the derivative
-        double vNew = vel - f / fp;
-        if (qAbs(vNew - vel) < TOL) {
-            if (vNew < 0)
-                return 0;
-            else if (vNew > 19) // 19 m/s == 70 km/h
-                return 70;
-            return vNew * 3.6;
-        } // success
-        vel = vNew;
-    }
-    return 0.0; // failed to converge
+    return routesimulator().maxSpeedFromPower(power, inclination);
 }
 
 double metric::calculatePowerFromSpeed(double speed, double inclination) {
-    QSettings settings;
-    double rolling_resistance = settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
-    double v = speed / 3.6; // converted to m/s;
-    double tv = v + 0;
-    double tran = 0.95;
-    const double aero = 0.22691607640851885;
-    double A2Eff = (tv > 0.0) ? aero : -aero; // wind in face, must reverse effect
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double tr = twt * ((inclination / 100.0) + rolling_resistance);
-    return (v * tr + v * tv * tv * A2Eff) / tran;
+    return routesimulator().powerFromSpeed(speed, inclination);
 }
 
 double metric::calculateSpeedFromPower(double power, double inclination, double speed, double deltaTimeSeconds, double speedLimit) {
-    QSettings settings;
-    if (inclination < -5)
-        inclination = -5;
-
-    double fullWeight = (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
-    double maxSpeed = calculateMaxSpeedFromPower(power, inclination);
-    double maxPowerFromSpeed = calculatePowerFromSpeed(speed, inclination);
-    double acceleration = (power - maxPowerFromSpeed) / fullWeight;
-    double newSpeed = speed + (acceleration * 3.6 * deltaTimeSeconds);
-    if(speedLimit > 0 && newSpeed > speedLimit)
-        newSpeed = speedLimit;
-    if(speedLimit > 0 && maxSpeed > speedLimit)
-        maxSpeed = speedLimit;
-    if(newSpeed < 0)
-        newSpeed = 0;
-    if (maxSpeed > newSpeed)
-        return newSpeed;
-    else if (maxSpeed < speed)
-        return newSpeed;
-    else
-        return maxSpeed;
+    return routesimulator().speedFromPower(power, inclination, speed, deltaTimeSeconds, speedLimit);
 }
 
 double metric::calculateWeightLoss(double kcal) {
@@ -293,7 +237,8 @@ double metric::calculateVO2Max(QList<SessionLine> *session) {
     // We're looking for intervals with durations in [windowSizeSecs, windowSizeSecs + secsDelta).
     foreach (SessionLine point, *session) {
 
-        total += point.watt;
+        // weighted by the sample interval so that sessions recorded faster than 1Hz give the same average
+        total += point.watt * (point.sampleIntervalMs / 1000.0);
         window.append(&session->at(i));
         double duration = window.last()->elapsedTime - window.first()->elapsedTime;
 
@@ -307,7 +252,7 @@ double metric::calculateVO2Max(QList<SessionLine> *session) {
             b.avg = avg;
             bests.append(b);
 
-            total -= window.first()->watt;
+            total -= window.first()->watt * (window.first()->sampleIntervalMs / 1000.0);
             window.removeFirst();
         }
         i++;
@@ -150,24 +150,26 @@ resistance_t pafersbike::pelotonToBikeResistance(int pelotonResistance) {
 }
 
 resistance_t pafersbike::resistanceFromPowerRequest(uint16_t power) {
-    qDebug() << QStringLiteral("resistanceFromPowerRequest") << Cadence.value();
-
-    for (resistance_t i = 1; i < max_resistance; i++) {
-        if (wattsFromResistance(i) <= power && wattsFromResistance(i + 1) >= power) {
-            qDebug() << QStringLiteral("resistanceFromPowerRequest") << wattsFromResistance(i)
-                     << wattsFromResistance(i + 1) << power;
-            return i;
-        }
+    if (!ergTable.isBuiltFor(1, max_resistance)) {
+        ergTable.build(1, max_resistance, [this](double cadence, resistance_t resistance) {
+            return wattsFromResistance(resistance, cadence);
+        });
     }
-    if (power < wattsFromResistance(1))
+    double cadence = currentCadence().value();
+    const powercalibration &calibration = powerCalibration();
+    int r = ergTable.resistanceFromPower(power, cadence, 1, max_resistance, calibration.gain(cadence),
+                                         calibration.offset());
+    if (r != -1)
+        return r;
+    if (power < calibration.apply(cadence, ergTable.watts(cadence, 1)))
         return 1;
     else
         return max_resistance;
 }
 
-uint16_t pafersbike::wattsFromResistance(double resistance) {
+uint16_t pafersbike::wattsFromResistance(double resistance, double cadence) {
     // to be changed
-    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (currentCadence().value()))));
+    return ((10.39 + 1.45 * (resistance - 1.0)) * (exp(0.028 * (cadence))));
 }
 
 double pafersbike::bikeResistanceToPeloton(double resistance) {
@@ -457,6 +459,7 @@ uint16_t pafersbike::watts() {
 void pafersbike::controllerStateChanged(QLowEnergyController::ControllerState state) {
     qDebug() << QStringLiteral("controllerStateChanged") << state;
     if (state == QLowEnergyController::UnconnectedState && m_control) {
+        ergTable.clear();
         lastResistanceBeforeDisconnection = Resistance.value();
         qDebug() << QStringLiteral("trying to connect back again...");
         initDone = false;
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "bike.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -39,7 +40,10 @@ class pafersbike : public bike {
     pafersbike(bool noWriteResistance, bool noHeartService, uint8_t bikeResistanceOffset, double bikeResistanceGain);
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t resistanceFromPowerRequest(uint16_t power);
+    bool hasResistancePowerModel() { return true; }
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(double resistance, double cadence);
     bool connected();
 
     void *VirtualBike();
@@ -49,7 +53,11 @@ class pafersbike : public bike {
     const resistance_t max_resistance = 24;
     double bikeResistanceToPeloton(double resistance);
     double GetDistanceFromPacket(const QByteArray &packet);
-    uint16_t wattsFromResistance(double resistance);
+    uint16_t wattsFromResistance(double resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     QTime GetElapsedFromPacket(const QByteArray &packet);
     void btinit();
     void writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log = false,
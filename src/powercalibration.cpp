@@ -0,0 +1,122 @@
+#include "powercalibration.h"
+#include "qzsettings.h"
+#include <QDebug>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QStringList>
+#include <QtMath>
+
+static QString settingsKey(const QString &deviceId) {
+    QString id = deviceId;
+    id.remove(QRegularExpression(QStringLiteral("[^0-9A-Za-z]")));
+    return QStringLiteral("power_calibration_") + id;
+}
+
+static void initCovariance(double P[3][3], double variance) {
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            P[i][j] = i == j ? variance : 0;
+}
+
+void powercalibration::clear() {
+    theta[0] = 100.0;
+    theta[1] = 0;
+    theta[2] = 0;
+    initCovariance(P, 1e4);
+    samples = 0;
+    unsaved = 0;
+    steady = 0;
+    lastCadence = -1;
+    lastResistance = -1;
+}
+
+void powercalibration::load(const QString &deviceId) {
+    if (deviceId == id)
+        return;
+    save();
+    clear();
+    id = deviceId;
+    QSettings settings;
+    enabled = settings.value(QZSettings::power_calibration, QZSettings::default_power_calibration).toBool();
+    if (id.isEmpty())
+        return;
+    QStringList values = settings.value(settingsKey(id)).toString().split(QLatin1Char(';'));
+    if (values.length() != 4)
+        return;
+    for (int i = 0; i < 3; i++)
+        theta[i] = values.at(i).toDouble();
+    samples = values.at(3).toInt();
+    // a stored fit is trusted more than the identity, still it can follow the drift of the unit
+    initCovariance(P, 1e2);
+    qDebug() << QStringLiteral("power calibration loaded") << id << theta[0] << theta[1] << theta[2] << samples;
+}
+
+void powercalibration::save() {
+    if (id.isEmpty() || unsaved == 0)
+        return;
+    QSettings settings;
+    settings.setValue(settingsKey(id), QStringLiteral("%1;%2;%3;%4")
+                                           .arg(theta[0], 0, 'g', 10)
+                                           .arg(theta[1], 0, 'g', 10)
+                                           .arg(theta[2], 0, 'g', 10)
+                                           .arg(samples));
+    unsaved = 0;
+}
+
+void powercalibration::addSample(double cadence, double resistance, double modelWatts, double measuredWatts) {
+    if (!enabled)
+        return;
+
+    // only steady samples: the power meter averages over a few seconds
+    if (qAbs(cadence - lastCadence) <= 5 && resistance == lastResistance)
+        steady++;
+    else
+        steady = 0;
+    lastCadence = cadence;
+    lastResistance = resistance;
+    if (steady < 3 || cadence < 30 || modelWatts <= 0 || measuredWatts < 30)
+        return;
+
+    const double x[3] = {modelWatts / 100.0, 1.0, modelWatts / 100.0 * (cadence - 80.0) / 100.0};
+    double predicted = theta[0] * x[0] + theta[1] * x[1] + theta[2] * x[2];
+    double error = measuredWatts - predicted;
+    if (samples >= minSamples && qAbs(error) > measuredWatts * 0.5 + 50)
+        return;
+
+    double Px[3];
+    double xPx = 0;
+    for (int i = 0; i < 3; i++) {
+        Px[i] = P[i][0] * x[0] + P[i][1] * x[1] + P[i][2] * x[2];
+        xPx += x[i] * Px[i];
+    }
+    double denominator = forgetting + xPx;
+    double trace = 0;
+    for (int i = 0; i < 3; i++) {
+        theta[i] += Px[i] / denominator * error;
+        for (int j = 0; j < 3; j++)
+            P[i][j] = (P[i][j] - Px[i] * Px[j] / denominator) / forgetting;
+        trace += P[i][i];
+    }
+    // without excitation the forgetting factor would make the covariance grow without limits
+    if (trace > 3e4) {
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 3; j++)
+                P[i][j] *= 3e4 / trace;
+    }
+
+    samples++;
+    if (++unsaved >= saveEvery)
+        save();
+}
+
+double powercalibration::gain(double cadence) const {
+    if (!isCalibrated())
+        return 1.0;
+    return qBound(0.5, (theta[0] + theta[2] * (cadence - 80.0) / 100.0) / 100.0, 2.0);
+}
+
+double powercalibration::offset() const {
+    if (!isCalibrated())
+        return 0;
+    return qBound(-100.0, theta[1], 100.0);
+}
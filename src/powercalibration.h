@@ -0,0 +1,52 @@
+#ifndef POWERCALIBRATION_H
+#define POWERCALIBRATION_H
+
+#include <QString>
+
+/**
+ * @brief Correction of the power model of a device (wattsFromResistance) learned from a reference power meter.
+ * The model is scaled as watts = model * (g0 + g1 * (cadence - 80) / 100) + offset, the coefficients are fitted with
+ * recursive least squares on every steady sample of the power sensor, so the fit costs a few multiplications per
+ * sample while riding. The coefficients are stored in the settings by device address.
+ */
+class powercalibration {
+  public:
+    powercalibration() { clear(); }
+    ~powercalibration() { save(); }
+
+    /**
+     * @brief Load the coefficients of a device, saving the ones of the previous device.
+     */
+    void load(const QString &deviceId);
+    void save();
+    const QString &deviceId() const { return id; }
+    bool isCalibrated() const { return enabled && samples >= minSamples; }
+    int sampleCount() const { return samples; }
+    void clear();
+
+    void addSample(double cadence, double resistance, double modelWatts, double measuredWatts);
+
+    // factor and offset to apply to the model, 1 and 0 until the device is calibrated
+    double gain(double cadence) const;
+    double offset() const;
+    double apply(double cadence, double modelWatts) const { return modelWatts * gain(cadence) + offset(); }
+
+  private:
+    static constexpr int minSamples = 300;
+    static constexpr int saveEvery = 60;
+    static constexpr double forgetting = 0.9995;
+
+    QString id;
+    bool enabled = false;
+    // coefficients of the features model / 100, 1, model / 100 * (cadence - 80) / 100
+    double theta[3];
+    double P[3][3];
+    int samples = 0;
+    int unsaved = 0;
+
+    double lastCadence = -1;
+    double lastResistance = -1;
+    int steady = 0;
+};
+
+#endif // POWERCALIBRATION_H
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "bike.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -39,7 +40,10 @@ class proformbike : public bike {
     proformbike(bool noWriteResistance, bool noHeartService, uint8_t bikeResistanceOffset, double bikeResistanceGain);
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t resistanceFromPowerRequest(uint16_t power);
+    bool hasResistancePowerModel() { return true; }
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(resistance_t resistance, double cadence);
     bool inclinationAvailableByHardware();
     bool connected();
 
@@ -48,7 +52,11 @@ class proformbike : public bike {
 
   private:
     resistance_t max_resistance = 16;
-    uint16_t wattsFromResistance(resistance_t resistance);
+    uint16_t wattsFromResistance(resistance_t resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     double GetDistanceFromPacket(QByteArray packet);
     QTime GetElapsedFromPacket(QByteArray packet);
     void btinit();
@@ -35,6 +35,7 @@
 #include <QString>
 
 #include "bike.h"
+#include "ergtable.h"
 #include "virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -48,7 +49,10 @@ class proformwifibike : public bike {
                     double bikeResistanceGain);
     resistance_t pelotonToBikeResistance(int pelotonResistance);
     resistance_t resistanceFromPowerRequest(uint16_t power);
+    bool hasResistancePowerModel() { return true; }
     resistance_t maxResistance() { return max_resistance; }
+    // the power model of the bike, used by the ERG mode
+    static uint16_t wattsFromResistance(resistance_t resistance, double cadence);
     bool inclinationAvailableByHardware();
     bool connected();
 
@@ -60,7 +64,11 @@ class proformwifibike : public bike {
     resistance_t max_resistance = 100;
     resistance_t min_resistance = -8;
     void connectToDevice();
-    uint16_t wattsFromResistance(resistance_t resistance);
+    uint16_t wattsFromResistance(resistance_t resistance) {
+        return wattsFromResistance(resistance, currentCadence().value());
+    }
+    double modelWatts() { return wattsFromResistance(Resistance.value()); }
+    ergtable ergTable;
     double GetDistanceFromPacket(QByteArray packet);
     QTime GetElapsedFromPacket(QByteArray packet);
     void btinit();
@@ -1,4 +1,4 @@
-QT += bluetooth widgets xml positioning quick networkauth websockets texttospeech location multimedia
+QT += bluetooth widgets xml positioning quick networkauth websockets texttospeech location multimedia concurrent
 QTPLUGIN += qavfmediaplayer
 QT+= charts
 
@@ -6,8 +6,8 @@ unix:android: QT += androidextras gui-private
 qtHaveModule(httpserver) {
     QT += httpserver
     DEFINES += Q_HTTPSERVER
-    SOURCES += webserverinfosender.cpp
-    HEADERS += webserverinfosender.h
+    SOURCES += webserverinfosender.cpp webassetcache.cpp
+    HEADERS += webserverinfosender.h webassetcache.h
 
     # android and iOS are using ChartJS
     unix:android: {
@@ -235,6 +235,19 @@ SOURCES += \
              m3ibike.cpp \
                 domyosbike.cpp \
                scanrecordresult.cpp \
+   workoutchartmodel.cpp \
+   workoutsnapshot.cpp \
+   ergtable.cpp \
+   ergcontroller.cpp \
+   powercalibration.cpp \
+   heartratesimulator.cpp \
+   heartratezonecontroller.cpp \
+   inclinationactuator.cpp \
+   routesimulator.cpp \
+   virtualgearing.cpp \
+   commandgovernor.cpp \
+   trainprogramtimeline.cpp \
+   workoutlibrary.cpp \
    zwiftworkout.cpp
 macx: SOURCES += macos/lockscreen.mm
 !ios: SOURCES += mainwindow.cpp charts.cpp
@@ -637,6 +650,19 @@ HEADERS += \
    wobjectimpl.h \
         yesoulbike.h \
         scanrecordresult.h \
+   workoutchartmodel.h \
+   workoutsnapshot.h \
+   ergtable.h \
+   ergcontroller.h \
+   powercalibration.h \
+   heartratesimulator.h \
+   heartratezonecontroller.h \
+   inclinationactuator.h \
+   routesimulator.h \
+   virtualgearing.h \
+   commandgovernor.h \
+   trainprogramtimeline.h \
+   workoutlibrary.h \
    zwiftworkout.h
 
 exists(secret.h): HEADERS += secret.h
@@ -196,10 +196,17 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         }
     }
 
+    uint64_t recordOffsetMs = 0;
+    for (uint32_t i = 0; i < firstRealIndex; i++) {
+        recordOffsetMs += session.at(i).sampleIntervalMs;
+    }
+
     for (int i = firstRealIndex; i < session.length(); i++) {
 
         fit::RecordMesg newRecord;
         sl = session.at(i);
+        uint64_t recordMs = recordOffsetMs;
+        recordOffsetMs += sl.sampleIntervalMs;
         // fit::DateTime date((time_t)session.at(i).time.toSecsSinceEpoch());
         newRecord.SetHeartRate(sl.heart);
         newRecord.SetCadence(sl.cadence);
@@ -231,7 +238,11 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         // using just the start point as reference in order to avoid pause time
         // strava ignore the elapsed field
         // this workaround could leads an accuracy issue.
-        newRecord.SetTimestamp(date.GetTimeStamp() + i);
+        newRecord.SetTimestamp(date.GetTimeStamp() + (recordMs / 1000));
+        if (recordMs % 1000) {
+            // sub-second samples: the fractional part goes in the 1/128s time field
+            newRecord.SetTime128((recordMs % 1000) / 1000.0);
+        }
         encode.Write(newRecord);
 
         if (sl.lapTrigger) {
@@ -441,8 +441,28 @@ const QString QZSettings::nordictrack_gx_2_7 = QStringLiteral("nordictrack_gx_2_
 const QString QZSettings::rolling_resistance = QStringLiteral("rolling_resistance");
 const QString QZSettings::wahoo_rgt_dircon = QStringLiteral("wahoo_rgt_dircon");
 const QString QZSettings::tts_description_enabled = QStringLiteral("tts_description_enabled");
+const QString QZSettings::session_sample_rate_hz = QStringLiteral("session_sample_rate_hz");
+const QString QZSettings::ui_refresh_interval_ms = QStringLiteral("ui_refresh_interval_ms");
+const QString QZSettings::zwift_erg_closed_loop = QStringLiteral("zwift_erg_closed_loop");
+const QString QZSettings::zwift_erg_settling_time = QStringLiteral("zwift_erg_settling_time");
+const QString QZSettings::zwift_erg_max_rate = QStringLiteral("zwift_erg_max_rate");
+const QString QZSettings::fakebike_erg_simulation = QStringLiteral("fakebike_erg_simulation");
+const QString QZSettings::power_calibration = QStringLiteral("power_calibration");
+const QString QZSettings::hr_zone_pid_kp = QStringLiteral("hr_zone_pid_kp");
+const QString QZSettings::hr_zone_pid_ki = QStringLiteral("hr_zone_pid_ki");
+const QString QZSettings::hr_zone_pid_kd = QStringLiteral("hr_zone_pid_kd");
+const QString QZSettings::hr_zone_pid_sample_time = QStringLiteral("hr_zone_pid_sample_time");
+const QString QZSettings::hr_zone_pid_actuator = QStringLiteral("hr_zone_pid_actuator");
+const QString QZSettings::default_hr_zone_pid_actuator = QStringLiteral("Auto");
+const QString QZSettings::inclination_predictive = QStringLiteral("inclination_predictive");
+const QString QZSettings::virtual_gearing = QStringLiteral("virtual_gearing");
+const QString QZSettings::virtual_gearing_wheel_circumference = QStringLiteral("virtual_gearing_wheel_circumference");
+const QString QZSettings::virtual_gearing_chainrings = QStringLiteral("virtual_gearing_chainrings");
+const QString QZSettings::default_virtual_gearing_chainrings = QStringLiteral("50,34");
+const QString QZSettings::virtual_gearing_cassette = QStringLiteral("virtual_gearing_cassette");
+const QString QZSettings::default_virtual_gearing_cassette = QStringLiteral("11,12,13,14,15,17,19,21,24,28");
 
-const uint32_t allSettingsCount = 370;
+const uint32_t allSettingsCount = 387;
 QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::cryptoKeySettingsProfiles, QZSettings::default_cryptoKeySettingsProfiles},
     {QZSettings::bluetooth_no_reconnection, QZSettings::default_bluetooth_no_reconnection},
@@ -815,7 +835,24 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::nordictrack_gx_2_7, QZSettings::default_nordictrack_gx_2_7},
     {QZSettings::rolling_resistance, QZSettings::default_rolling_resistance},
     {QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon},
-    {QZSettings::tts_description_enabled, QZSettings::default_tts_description_enabled}};
+    {QZSettings::tts_description_enabled, QZSettings::default_tts_description_enabled},
+    {QZSettings::session_sample_rate_hz, QZSettings::default_session_sample_rate_hz},
+    {QZSettings::ui_refresh_interval_ms, QZSettings::default_ui_refresh_interval_ms},
+    {QZSettings::zwift_erg_closed_loop, QZSettings::default_zwift_erg_closed_loop},
+    {QZSettings::zwift_erg_settling_time, QZSettings::default_zwift_erg_settling_time},
+    {QZSettings::zwift_erg_max_rate, QZSettings::default_zwift_erg_max_rate},
+    {QZSettings::fakebike_erg_simulation, QZSettings::default_fakebike_erg_simulation},
+    {QZSettings::power_calibration, QZSettings::default_power_calibration},
+    {QZSettings::hr_zone_pid_kp, QZSettings::default_hr_zone_pid_kp},
+    {QZSettings::hr_zone_pid_ki, QZSettings::default_hr_zone_pid_ki},
+    {QZSettings::hr_zone_pid_kd, QZSettings::default_hr_zone_pid_kd},
+    {QZSettings::hr_zone_pid_sample_time, QZSettings::default_hr_zone_pid_sample_time},
+    {QZSettings::hr_zone_pid_actuator, QZSettings::default_hr_zone_pid_actuator},
+    {QZSettings::inclination_predictive, QZSettings::default_inclination_predictive},
+    {QZSettings::virtual_gearing, QZSettings::default_virtual_gearing},
+    {QZSettings::virtual_gearing_wheel_circumference, QZSettings::default_virtual_gearing_wheel_circumference},
+    {QZSettings::virtual_gearing_chainrings, QZSettings::default_virtual_gearing_chainrings},
+    {QZSettings::virtual_gearing_cassette, QZSettings::default_virtual_gearing_cassette}};
 
 void QZSettings::qDebugAllSettings(bool showDefaults) {
     QSettings settings;
@@ -1336,6 +1336,57 @@ class QZSettings {
     static const QString tts_description_enabled;
     static constexpr bool default_tts_description_enabled = true;
 
+    static const QString session_sample_rate_hz;
+    static constexpr int default_session_sample_rate_hz = 1;
+
+    static const QString ui_refresh_interval_ms;
+    static constexpr int default_ui_refresh_interval_ms = 1000;
+
+    static const QString zwift_erg_closed_loop;
+    static constexpr bool default_zwift_erg_closed_loop = false;
+
+    static const QString zwift_erg_settling_time;
+    static constexpr double default_zwift_erg_settling_time = 12.0;
+
+    static const QString zwift_erg_max_rate;
+    static constexpr double default_zwift_erg_max_rate = 1.0;
+
+    static const QString fakebike_erg_simulation;
+    static constexpr bool default_fakebike_erg_simulation = false;
+
+    static const QString power_calibration;
+    static constexpr bool default_power_calibration = false;
+
+    static const QString hr_zone_pid_kp;
+    static constexpr double default_hr_zone_pid_kp = 0.0;
+
+    static const QString hr_zone_pid_ki;
+    static constexpr double default_hr_zone_pid_ki = 1.0;
+
+    static const QString hr_zone_pid_kd;
+    static constexpr double default_hr_zone_pid_kd = 0.0;
+
+    static const QString hr_zone_pid_sample_time;
+    static constexpr uint32_t default_hr_zone_pid_sample_time = 10;
+
+    static const QString hr_zone_pid_actuator;
+    static const QString default_hr_zone_pid_actuator;
+
+    static const QString inclination_predictive;
+    static constexpr bool default_inclination_predictive = false;
+
+    static const QString virtual_gearing;
+    static constexpr bool default_virtual_gearing = false;
+
+    static const QString virtual_gearing_wheel_circumference;
+    static constexpr double default_virtual_gearing_wheel_circumference = 2.105;
+
+    static const QString virtual_gearing_chainrings;
+    static const QString default_virtual_gearing_chainrings;
+
+    static const QString virtual_gearing_cassette;
+    static const QString default_virtual_gearing_cassette;
+
     /**
      * @brief Write the QSettings values using the constants from this namespace.
      * @param showDefaults Optionally indicates if the default should be shown with the key.
@@ -133,7 +133,7 @@ void renphobike::update() {
 
                     requestResistance = -1;
                 } else if (lastRequestResistance != -1) {
-                    int8_t r = lastRequestResistance * m_difficult + gears();
+                    int8_t r = lastRequestResistance * m_difficult + gearsOffset();
                     debug("writing resistance for renpho forever " + QString::number(r));
                     forceResistance(r);
                 }
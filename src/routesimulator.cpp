@@ -0,0 +1,116 @@
+#include "routesimulator.h"
+#include "qzsettings.h"
+#include "trainprogram.h"
+#include <QSettings>
+#include <QtMath>
+
+routesimulator::routesimulator() {
+    QSettings settings;
+    rolling = settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
+    mass = (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
+            settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
+}
+
+double routesimulator::maxSpeedFromPower(double power, double inclination) const {
+    double twt = 9.8 * mass;
+    double hw = 0; // wind speed
+    double tr = twt * ((inclination / 100.0) + rolling);
+    double p = power;
+    double vel = 20;        // Initial guess
+    const uint8_t MAX = 10; // maximum iterations
+    double TOL = 0.05;      // tolerance
+    for (int i = 1; i < MAX; i++) {
+        double tv = vel + hw;
+        double aeroEff = (tv > 0.0) ? aero : -aero;                   // wind in face, must reverse effect
+        double f = vel * (aeroEff * tv * tv + tr) - transmission * p; // the function
+        double fp = aeroEff * (3.0 * vel + hw) * tv + tr;             // the derivative
+        double vNew = vel - f / fp;
+        if (qAbs(vNew - vel) < TOL) {
+            if (vNew < 0)
+                return 0;
+            else if (vNew > 19) // 19 m/s == 70 km/h
+                return 70;
+            return vNew * 3.6;
+        } // success
+        vel = vNew;
+    }
+    return 0.0; // failed to converge
+}
+
+double routesimulator::powerFromSpeed(double speed, double inclination, double windSpeed) const {
+    double v = speed / 3.6; // converted to m/s;
+    double tv = v + windSpeed;
+    double A2Eff = (tv > 0.0) ? aero : -aero; // wind in face, must reverse effect
+    double twt = 9.8 * mass;
+    double tr = twt * ((inclination / 100.0) + rolling);
+    return (v * tr + v * tv * tv * A2Eff) / transmission;
+}
+
+double routesimulator::gradeFromPower(double power, double speed, double windSpeed) const {
+    double v = speed / 3.6; // converted to m/s;
+    if (v <= 0)
+        return 0;
+    double tv = v + windSpeed;
+    double A2Eff = (tv > 0.0) ? aero : -aero;
+    double twt = 9.8 * mass;
+    return ((power * transmission - v * tv * tv * A2Eff) / (v * twt) - rolling) * 100.0;
+}
+
+double routesimulator::speedFromPower(double power, double inclination, double speed, double deltaTimeSeconds,
+                                      double speedLimit) const {
+    if (inclination < -5)
+        inclination = -5;
+
+    double maxSpeed = maxSpeedFromPower(power, inclination);
+    double maxPowerFromSpeed = powerFromSpeed(speed, inclination);
+    double acceleration = (power - maxPowerFromSpeed) / mass;
+    double newSpeed = speed + (acceleration * 3.6 * deltaTimeSeconds);
+    if (speedLimit > 0 && newSpeed > speedLimit)
+        newSpeed = speedLimit;
+    if (speedLimit > 0 && maxSpeed > speedLimit)
+        maxSpeed = speedLimit;
+    if (newSpeed < 0)
+        newSpeed = 0;
+    if (maxSpeed > newSpeed)
+        return newSpeed;
+    else if (maxSpeed < speed)
+        return newSpeed;
+    else
+        return maxSpeed;
+}
+
+QVector<routesimulator::row> routesimulator::simulate(const QList<trainrow> &rows, double power, double speed,
+                                                       int from, double fromDistance) const {
+    QVector<row> simulation;
+    if (from < 0 || from >= rows.length())
+        return simulation;
+    simulation.reserve(rows.length() - from);
+
+    double elapsed = 0;
+    for (int i = from; i < rows.length(); i++) {
+        const trainrow &r = rows.at(i);
+        double inclination = r.inclination != -200 ? r.inclination : 0;
+        row s;
+        if (speed > 0) {
+            s.speed = (r.forcespeed && r.speed > 0) ? r.speed : speed;
+            s.power = qMax(0.0, powerFromSpeed(s.speed, inclination));
+        } else {
+            s.power = r.power > 0 ? r.power : power;
+            s.speed = maxSpeedFromPower(s.power, inclination);
+        }
+
+        if (r.distance > 0) {
+            s.distance = r.distance;
+            if (i == from)
+                s.distance = qMax(0.0, s.distance - fromDistance);
+            s.seconds = s.speed >= minSpeed ? s.distance / s.speed * 3600.0 : 0;
+        } else {
+            s.seconds = r.duration.second() + (r.duration.minute() * 60) + (r.duration.hour() * 3600);
+            s.distance = s.speed * s.seconds / 3600.0;
+        }
+        elapsed += s.seconds;
+        s.elapsed = elapsed;
+        simulation.append(s);
+    }
+    return simulation;
+}
@@ -0,0 +1,77 @@
+#ifndef ROUTESIMULATOR_H
+#define ROUTESIMULATOR_H
+
+#include <QList>
+#include <QVector>
+
+class trainrow;
+
+/**
+ * @brief Physics of a rider on a road (weight, rolling resistance, aerodynamic drag), with the settings read once.
+ * The metric::calculate* functions are single evaluations of this model; simulate() runs it on all the rows of a
+ * train program or of a GPX route in one pass, reading the settings only once.
+ */
+class routesimulator {
+  public:
+    struct row {
+        double seconds = 0;  // predicted duration of the row
+        double distance = 0; // km
+        double speed = 0;    // km/h
+        double power = 0;    // watts
+        double elapsed = 0;  // seconds from the start of the simulation to the end of the row
+    };
+
+    routesimulator();
+
+    /**
+     * @brief The steady speed at a power on a grade. Units: km/h
+     */
+    double maxSpeedFromPower(double power, double inclination) const;
+    /**
+     * @brief The power to keep a speed (km/h) on a grade. Units: watts
+     * @param windSpeed The head wind, negative for tail wind. Unit: m/s
+     */
+    double powerFromSpeed(double speed, double inclination, double windSpeed = 0) const;
+    /**
+     * @brief The grade where a power keeps a speed (km/h), the inverse of powerFromSpeed. Units: %
+     */
+    double gradeFromPower(double power, double speed, double windSpeed = 0) const;
+    /**
+     * @brief Replace the rolling resistance coefficient of the settings, e.g. with the one sent by a game.
+     */
+    void setRollingResistance(double crr) { rolling = crr; }
+    /**
+     * @brief The speed (km/h) after deltaTimeSeconds at a power, starting from speed.
+     */
+    double speedFromPower(double power, double inclination, double speed, double deltaTimeSeconds,
+                          double speedLimit) const;
+
+    /**
+     * @brief Simulate the rows at a constant power or at a constant speed. The rows with a power (power mode) or a
+     * forced speed (speed mode) use it instead of the constant one, the rows without inclination are flat. The rows
+     * by distance slower than minSpeed have an unknown duration and get 0 seconds.
+     * @param power The power of the rider, used when speed is 0. Unit: watts
+     * @param speed The speed of the rider, 0 for the power mode. Unit: km/h
+     * @param from The first row to simulate
+     * @param fromDistance The distance already done in the first row. Unit: km
+     */
+    QVector<row> simulate(const QList<trainrow> &rows, double power, double speed = 0, int from = 0,
+                          double fromDistance = 0) const;
+    /**
+     * @brief The total seconds of a simulation.
+     */
+    static double duration(const QVector<row> &simulation) {
+        return simulation.isEmpty() ? 0 : simulation.last().elapsed;
+    }
+
+    // km/h, e.g. 0 watts uphill: no time to the end of a row by distance
+    static constexpr double minSpeed = 1.0;
+
+  private:
+    double mass;    // rider and bike, kg
+    double rolling; // rolling resistance coefficient
+    static constexpr double aero = 0.22691607640851885;
+    static constexpr double transmission = 0.95;
+};
+
+#endif // ROUTESIMULATOR_H
@@ -35,7 +35,10 @@ metric rower::pelotonResistance() { return m_pelotonResistance; }
 resistance_t rower::pelotonToBikeResistance(int pelotonResistance) { return pelotonResistance; }
 resistance_t rower::resistanceFromPowerRequest(uint16_t power) { return power / 10; } // in order to have something
 void rower::cadenceSensor(uint8_t cadence) { Cadence.setValue(cadence); }
-void rower::powerSensor(uint16_t power) { m_watt.setValue(power, false); }
+void rower::powerSensor(uint16_t power) {
+    m_watt.setValue(power, false);
+    learnPowerCurve(power);
+}
 
 bluetoothdevice::BLUETOOTH_TYPE rower::deviceType() { return bluetoothdevice::ROWING; }
 
@@ -32,6 +32,8 @@ class SessionLine {
     double instantaneousStrideLengthCM;
     double groundContactMS;
     double verticalOscillationMM;
+    // time covered by this line, the session can be sampled faster than 1Hz
+    uint16_t sampleIntervalMs = 1000;
 
     SessionLine();
     SessionLine(double speed, int8_t inclination, double distance, uint16_t watt, resistance_t resistance,
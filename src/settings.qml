@@ -16,6 +16,7 @@ import Qt.labs.settings 1.0
 
         Settings {
             id: settings
+            Component.onCompleted: rootItem.watchSettings(settings)
             property real ui_zoom: 100.0
             property bool bike_heartrate_service: false
             property int bike_resistance_offset: 4
@@ -489,6 +490,25 @@ import Qt.labs.settings 1.0
 
             // from version 2.11.73
             property bool tts_description_enabled: true
+
+            // from version 2.11.78
+            property int session_sample_rate_hz: 1
+            property int ui_refresh_interval_ms: 1000
+            property bool zwift_erg_closed_loop: false
+            property real zwift_erg_settling_time: 12.0
+            property real zwift_erg_max_rate: 1.0
+            property bool fakebike_erg_simulation: false
+            property bool power_calibration: false
+            property real hr_zone_pid_kp: 0.0
+            property real hr_zone_pid_ki: 1.0
+            property real hr_zone_pid_kd: 0.0
+            property int hr_zone_pid_sample_time: 10
+            property string hr_zone_pid_actuator: "Auto"
+            property bool inclination_predictive: false
+            property bool virtual_gearing: false
+            property real virtual_gearing_wheel_circumference: 2.105
+            property string virtual_gearing_chainrings: "50,34"
+            property string virtual_gearing_cassette: "11,12,13,14,15,17,19,21,24,28"
         }
 
         function paddingZeros(text, limit) {
@@ -759,6 +779,69 @@ import Qt.labs.settings 1.0
                         Layout.fillWidth: true
                         onClicked: settings.continuous_moving = checked
                     }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelSessionSampleRate
+                            text: qsTr("Session Sample Rate (Hz):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: sessionSampleRateTextField
+                            text: settings.session_sample_rate_hz
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.session_sample_rate_hz = Math.max(1, Math.min(10, text))
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okSessionSampleRateButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.session_sample_rate_hz = Math.max(1, Math.min(10, sessionSampleRateTextField.text))
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelUiRefreshInterval
+                            text: qsTr("UI Refresh Interval (ms):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: uiRefreshIntervalTextField
+                            text: settings.ui_refresh_interval_ms
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.ui_refresh_interval_ms = Math.max(1000, text)
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okUiRefreshIntervalButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.ui_refresh_interval_ms = Math.max(1000, uiRefreshIntervalTextField.text)
+                        }
+                    }
+
+                    Label {
+                        id: sampleRateLabel
+                        text: qsTr("The sample rate (1-10 Hz) is the resolution of the workout history and of the FIT file. A longer refresh interval (min 1000 ms) makes the tiles lighter on slow devices.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 8
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Yellow)
+                    }
                 }
             }
 
@@ -1402,6 +1485,176 @@ import Qt.labs.settings 1.0
                         }
                     }
 
+                    SwitchDelegate {
+                        id: zwiftErgClosedLoopDelegate
+                        text: qsTr("ERG Closed Loop (adjust the resistance on the measured power)")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.zwift_erg_closed_loop
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: settings.zwift_erg_closed_loop = checked
+                    }
+
+                    SwitchDelegate {
+                        id: powerCalibrationDelegate
+                        text: qsTr("Learn the Power Curve of the Bike from the Power Sensor")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.power_calibration
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: settings.power_calibration = checked
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelZwiftErgSettlingTime
+                            text: qsTr("ERG Closed Loop Settling Time (s):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: zwiftErgSettlingTimeTextField
+                            text: settings.zwift_erg_settling_time
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.zwift_erg_settling_time = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okZwiftErgSettlingTimeButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.zwift_erg_settling_time = zwiftErgSettlingTimeTextField.text
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelZwiftErgMaxRate
+                            text: qsTr("ERG Closed Loop Max. Levels per Second:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: zwiftErgMaxRateTextField
+                            text: settings.zwift_erg_max_rate
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.zwift_erg_max_rate = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okZwiftErgMaxRateButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.zwift_erg_max_rate = zwiftErgMaxRateTextField.text
+                        }
+                    }
+
+                    SwitchDelegate {
+                        id: virtualGearingDelegate
+                        text: qsTr("Virtual Gearing (shift with the gear buttons in simulation mode)")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.virtual_gearing
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: settings.virtual_gearing = checked
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelVirtualGearingChainrings
+                            text: qsTr("Virtual Gearing Chainrings (teeth, comma separated):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: virtualGearingChainringsTextField
+                            text: settings.virtual_gearing_chainrings
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhPreferNumbers
+                            onAccepted: settings.virtual_gearing_chainrings = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okVirtualGearingChainringsButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.virtual_gearing_chainrings = virtualGearingChainringsTextField.text
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelVirtualGearingCassette
+                            text: qsTr("Virtual Gearing Cassette (teeth, comma separated):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: virtualGearingCassetteTextField
+                            text: settings.virtual_gearing_cassette
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhPreferNumbers
+                            onAccepted: settings.virtual_gearing_cassette = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okVirtualGearingCassetteButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.virtual_gearing_cassette = virtualGearingCassetteTextField.text
+                        }
+                    }
+
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelVirtualGearingWheelCircumference
+                            text: qsTr("Virtual Gearing Wheel Circumference (m):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: virtualGearingWheelCircumferenceTextField
+                            text: settings.virtual_gearing_wheel_circumference
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.virtual_gearing_wheel_circumference = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okVirtualGearingWheelCircumferenceButton
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.virtual_gearing_wheel_circumference = virtualGearingWheelCircumferenceTextField.text
+                        }
+                    }
+
                     RowLayout {
                         spacing: 10
                         Label {
@@ -3990,6 +4243,128 @@ import Qt.labs.settings 1.0
                             onClicked: settings.treadmill_pid_heart_zone = treadmillPidHRTextField.displayText
                         }
                     }
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelHRZonePidActuator
+                            text: qsTr("PID on Heart Zone actuator:")
+                            Layout.fillWidth: true
+                        }
+                        ComboBox {
+                            id: hrZonePidActuatorTextField
+                            model: [ "Auto", "Speed", "Inclination", "Resistance", "Power" ]
+                            displayText: settings.hr_zone_pid_actuator
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onActivated: {
+                                console.log("combomodel activated" + hrZonePidActuatorTextField.currentIndex)
+                                displayText = hrZonePidActuatorTextField.currentValue
+                             }
+
+                        }
+                        Button {
+                            id: okHRZonePidActuator
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.hr_zone_pid_actuator = hrZonePidActuatorTextField.displayText
+                        }
+                    }
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelHRZonePidSampleTime
+                            text: qsTr("PID on Heart Zone sample time (s):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: hrZonePidSampleTimeTextField
+                            text: settings.hr_zone_pid_sample_time
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.hr_zone_pid_sample_time = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okHRZonePidSampleTime
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.hr_zone_pid_sample_time = hrZonePidSampleTimeTextField.text
+                        }
+                    }
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelHRZonePidKp
+                            text: qsTr("PID on Heart Zone Kp:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: hrZonePidKpTextField
+                            text: settings.hr_zone_pid_kp
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.hr_zone_pid_kp = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okHRZonePidKp
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.hr_zone_pid_kp = hrZonePidKpTextField.text
+                        }
+                    }
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelHRZonePidKi
+                            text: qsTr("PID on Heart Zone Ki:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: hrZonePidKiTextField
+                            text: settings.hr_zone_pid_ki
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.hr_zone_pid_ki = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okHRZonePidKi
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.hr_zone_pid_ki = hrZonePidKiTextField.text
+                        }
+                    }
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            id: labelHRZonePidKd
+                            text: qsTr("PID on Heart Zone Kd:")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: hrZonePidKdTextField
+                            text: settings.hr_zone_pid_kd
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhFormattedNumbersOnly
+                            onAccepted: settings.hr_zone_pid_kd = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            id: okHRZonePidKd
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: settings.hr_zone_pid_kd = hrZonePidKdTextField.text
+                        }
+                    }
                 }
 
 
@@ -4136,6 +4511,21 @@ import Qt.labs.settings 1.0
                     }
                 }
 
+                SwitchDelegate {
+                    id: inclinationPredictiveDelegate
+                    text: qsTr("Anticipate the Inclination Changes")
+                    spacing: 0
+                    bottomPadding: 0
+                    topPadding: 0
+                    rightPadding: 0
+                    leftPadding: 0
+                    clip: false
+                    checked: settings.inclination_predictive
+                    Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                    Layout.fillWidth: true
+                    onClicked: settings.inclination_predictive = checked
+                }
+
                 AccordionCheckElement {
                     id: trainingProgramRandomAccordion
                     title: qsTr("Training Program Random Options")
@@ -6850,6 +7240,21 @@ import Qt.labs.settings 1.0
                         onClicked: settings.applewatch_fakedevice = checked
                     }
 
+                    SwitchDelegate {
+                        id: fakeBikeErgSimulationDelegate
+                        text: qsTr("Fake Device ERG Simulation")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.fakebike_erg_simulation
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: settings.fakebike_erg_simulation = checked
+                    }
+
                     SwitchDelegate {
                         id: fakeTreadmillDelegate
                         text: qsTr("Fake Treadmill")
@@ -118,8 +118,8 @@ void tacxneo2::update() {
         }
         if (requestInclination != -100) {
             emit debug(QStringLiteral("writing inclination ") + QString::number(requestInclination));
-            forceInclination(requestInclination + gears()); // since this bike doesn't have the concept of resistance,
-                                                            // i'm using the gears in the inclination
+            // since this bike doesn't have the concept of resistance, i'm using the gears in the inclination
+            forceInclination(requestInclination + gearsOffset());
             requestInclination = -100;
         }
 
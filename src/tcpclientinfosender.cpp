@@ -1,6 +1,10 @@
 #include "tcpclientinfosender.h"
+#include <QRandomGenerator>
 
-TcpClientInfoSender::TcpClientInfoSender(const QString &id, QObject *parent) : TemplateInfoSender(id, parent) {}
+TcpClientInfoSender::TcpClientInfoSender(const QString &id, QObject *parent) : TemplateInfoSender(id, parent) {
+    flushTimer.setSingleShot(true);
+    connect(&flushTimer, &QTimer::timeout, this, &TcpClientInfoSender::flush);
+}
 TcpClientInfoSender::~TcpClientInfoSender() {
     TcpClientInfoSender::innerStop(); // NOTE: clang-analyzer-optin-cplusplus-virtualcall
 }
@@ -8,12 +12,47 @@ TcpClientInfoSender::~TcpClientInfoSender() {
 bool TcpClientInfoSender::isRunning() const { return tcpSocket && tcpSocket->state() == QTcpSocket::ConnectedState; }
 
 bool TcpClientInfoSender::send(const QString &data) {
-    if (isRunning()) {
-        return tcpSocket->write(data.toLatin1()) > 0;
-    } else if (tcpSocket) {
+    QByteArray message = data.toLatin1();
+    if (message.isEmpty()) {
+        return false;
+    }
+    // while the connection is down or slow the messages wait in a bounded queue, dropping the oldest ones
+    while (!outQueue.isEmpty() && queuedBytes + message.size() > maxQueueBytes) {
+        queuedBytes -= outQueue.takeFirst().size();
+        if ((++droppedMessages % 100) == 1) {
+            qDebug() << QStringLiteral("TcpClientInfoSender") << templateId << QStringLiteral("dropped")
+                     << droppedMessages << QStringLiteral("messages");
+        }
+    }
+    outQueue.append(message);
+    queuedBytes += message.size();
+    if (flushIntervalMs <= 0) {
+        flush();
+    } else if (!flushTimer.isActive()) {
+        flushTimer.start(flushIntervalMs);
+    }
+    if (!isRunning() && tcpSocket) {
         qDebug() << QStringLiteral("TcpSocket state is ") << tcpSocket->state();
     }
-    return false;
+    return true;
+}
+
+void TcpClientInfoSender::flush() {
+    // nothing is added to the socket buffer until it has sent what it already has
+    if (outQueue.isEmpty() || !isRunning() || tcpSocket->bytesToWrite() > maxQueueBytes) {
+        return;
+    }
+    tcpSocket->write(outQueue.join());
+    outQueue.clear();
+    queuedBytes = 0;
+}
+
+int TcpClientInfoSender::retryDelayMs() {
+    // exponential backoff from 1s to 60s, with a random jitter so many clients don't reconnect all together
+    int delay = 1000 << qMin(reconnectAttempts, 6);
+    delay = qMin(delay, 60000);
+    reconnectAttempts++;
+    return delay / 2 + (int)QRandomGenerator::global()->bounded(delay / 2 + 1);
 }
 
 void TcpClientInfoSender::innerStop() {
@@ -51,17 +90,35 @@ bool TcpClientInfoSender::init() {
     if (ip.isEmpty()) {
         ip = QStringLiteral("127.0.0.1");
     }
+    flushIntervalMs =
+        settings.value(QStringLiteral("template_") + templateId + QStringLiteral("_flush_ms"), 50).toInt(&ok);
+    if (!ok) {
+        flushIntervalMs = 50;
+    }
+    maxQueueBytes = settings.value(QStringLiteral("template_") + templateId + QStringLiteral("_max_queue_bytes"),
+                                   64 * 1024)
+                        .toInt(&ok);
+    if (!ok || maxQueueBytes <= 0) {
+        maxQueueBytes = 64 * 1024;
+    }
+    // the socket of the previous attempt, if any
+    innerStop();
     tcpSocket = new QTcpSocket(this);
     connect(tcpSocket, &QAbstractSocket::connected, this, &TcpClientInfoSender::debugConnected);
     connect(tcpSocket, SIGNAL(connectionClosed()), this, SLOT(reinit()));
     connect(tcpSocket, &QIODevice::readyRead, this, &TcpClientInfoSender::readyRead);
+    connect(tcpSocket, &QIODevice::bytesWritten, this, &TcpClientInfoSender::flush);
     connect(tcpSocket, SIGNAL(error(int)), this, SLOT(socketError(int)));
     connect(tcpSocket, &QAbstractSocket::stateChanged, this, &TcpClientInfoSender::stateChanged);
     tcpSocket->connectToHost(ip, (uint16_t)port);
     return true;
 }
 
-void TcpClientInfoSender::debugConnected() { qDebug() << "Connected" << tcpSocket->state(); }
+void TcpClientInfoSender::debugConnected() {
+    qDebug() << "Connected" << tcpSocket->state();
+    reconnectAttempts = 0;
+    flush();
+}
 
 void TcpClientInfoSender::socketError(int err) {
     qDebug() << QStringLiteral("SocketError") << err;
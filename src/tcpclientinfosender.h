@@ -2,7 +2,9 @@
 #define TCPCLIENTINFOSENDER_H
 
 #include "templateinfosender.h"
+#include <QByteArrayList>
 #include <QTcpSocket>
+#include <QTimer>
 
 class TcpClientInfoSender : public TemplateInfoSender {
     Q_OBJECT
@@ -18,7 +20,21 @@ class TcpClientInfoSender : public TemplateInfoSender {
     int port;
     virtual bool init();
     virtual void innerStop();
+    virtual int retryDelayMs();
+
+  private:
+    // the messages are written together every flushIntervalMs: a congested network gets few large segments
+    QTimer flushTimer;
+    int flushIntervalMs = 50;
+    // messages not written yet, at most maxQueueBytes: the oldest ones are dropped
+    QByteArrayList outQueue;
+    int queuedBytes = 0;
+    int maxQueueBytes = 64 * 1024;
+    quint64 droppedMessages = 0;
+    // failed connections in a row, for the exponential backoff
+    int reconnectAttempts = 0;
   private slots:
+    void flush();
     void readyRead();
     void debugConnected();
     void socketError(int err);
@@ -1,5 +1,7 @@
 #include "templateinfosender.h"
 #include "qdebugfixup.h"
+#include "workoutsnapshot.h"
+#include <QElapsedTimer>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -15,18 +17,67 @@ TemplateInfoSender::TemplateInfoSender(const QString &id, QObject *parent) : QOb
 TemplateInfoSender::~TemplateInfoSender() { stop(); }
 
 bool TemplateInfoSender::init(const QString &script) {
-    jscript = script;
+    setScript(script);
     stop();
     return init();
 }
 
+void TemplateInfoSender::setScript(const QString &script) {
+    jscript = script;
+    compiled = QJSValue();
+    compiledEngine = nullptr;
+    compileFailed = false;
+}
+
+bool TemplateInfoSender::compile(QJSEngine *eng) {
+    // the templates are a list of statements where the last one is the expression to send
+    // (for example getstring(this.workout)): they are wrapped in a function returning that expression,
+    // evaluated only once, and then called on every update
+    QStringList lines = jscript.split('\n');
+    int last = lines.size() - 1;
+    while (last >= 0 &&
+           (lines.at(last).trimmed().isEmpty() || lines.at(last).trimmed().startsWith(QStringLiteral("//"))))
+        last--;
+    if (last < 0)
+        return false;
+    QString expression = lines.at(last).trimmed();
+    if (expression.endsWith(';'))
+        expression.chop(1);
+    if (expression.isEmpty() || expression.startsWith('}') || expression.endsWith('{'))
+        return false;
+
+    QString body = QStringList(lines.mid(0, last)).join('\n');
+    QJSValue fn = eng->evaluate(QStringLiteral("(function(workout) {\n") + body + QStringLiteral("\nreturn (") +
+                                expression + QStringLiteral(");\n})"));
+    if (fn.isError() || !fn.isCallable()) {
+        qDebug() << QStringLiteral("Template") << templateId
+                 << QStringLiteral("can't be compiled, it will be evaluated on every update");
+        return false;
+    }
+    compiled = fn;
+    compiledEngine = eng;
+    qDebug() << QStringLiteral("Template") << templateId << QStringLiteral("compiled");
+    return true;
+}
+
 bool TemplateInfoSender::update(QJSEngine *eng) {
     if (!jscript.isEmpty()) {
-        QJSValue jsv = eng->evaluate(jscript);
+        if (compiledEngine != eng && !compileFailed) {
+            compileFailed = !compile(eng);
+        }
+        QJSValue jsv;
+        QElapsedTimer evalTimer;
+        evalTimer.start();
+        if (!compileFailed) {
+            QJSValue glob = eng->globalObject();
+            jsv = compiled.callWithInstance(glob, QJSValueList() << glob.property(QStringLiteral("workout")));
+        } else {
+            jsv = eng->evaluate(jscript);
+        }
+        evalTotalNs += evalTimer.nsecsElapsed();
+        evalTotalCount++;
         if (!jsv.isError()) {
-            QString evalres = jsv.toString();
-            qDebug() << QStringLiteral("eval res ") << evalres;
-            return send(evalres);
+            return send(jsv.toString());
         } else {
 #if (QT_VERSION < QT_VERSION_CHECK(5, 12, 0))
             int errorType = 255;
@@ -41,6 +92,10 @@ bool TemplateInfoSender::update(QJSEngine *eng) {
     }
 }
 
+bool TemplateInfoSender::sendWorkout(const WorkoutSnapshot &snapshot) {
+    return send(QString::fromUtf8(snapshot.message()));
+}
+
 QString TemplateInfoSender::js() const { return jscript; }
 
 QString TemplateInfoSender::getId() const { return templateId; }
@@ -52,7 +107,12 @@ void TemplateInfoSender::stop() {
 
 void TemplateInfoSender::innerStop() {}
 
+int TemplateInfoSender::retryDelayMs() { return 5000; }
+
 void TemplateInfoSender::reinit() {
+    // the errors and the state changes of a connection often come together: one retry is enough
+    if (retryTimer.isActive())
+        return;
     stop();
-    retryTimer.start(5s);
+    retryTimer.start(retryDelayMs());
 }
@@ -5,6 +5,8 @@
 #include <QSettings>
 #include <QTimer>
 
+class WorkoutSnapshot;
+
 class TemplateInfoSender : public QObject {
     Q_OBJECT
   public:
@@ -12,17 +14,27 @@ class TemplateInfoSender : public QObject {
     virtual ~TemplateInfoSender();
     virtual bool isRunning() const = 0;
     virtual bool send(const QString &data) = 0;
+    /**
+     * @brief Send the workout message of the snapshot without running the template script.
+     */
+    virtual bool sendWorkout(const WorkoutSnapshot &snapshot);
     bool init(const QString &script);
+    void setScript(const QString &script);
     void stop();
     bool update(QJSEngine *eng);
     QString js() const;
     QString getId() const;
+    // time spent running the script and number of runs, for the metrics endpoint
+    qint64 evalTimeNs() const { return evalTotalNs; }
+    quint64 evalCount() const { return evalTotalCount; }
   signals:
     void onDataReceived(QByteArray data);
 
   protected:
     virtual bool init() = 0;
     virtual void innerStop();
+    // delay before init() is tried again after reinit()
+    virtual int retryDelayMs();
     QString templateId;
     QSettings settings;
     QString jscript;
@@ -30,7 +42,14 @@ class TemplateInfoSender : public QObject {
     void reinit();
 
   private:
+    bool compile(QJSEngine *eng);
     QTimer retryTimer;
+    // the template compiled once as a function, see compile()
+    QJSValue compiled;
+    QJSEngine *compiledEngine = nullptr;
+    bool compileFailed = false;
+    qint64 evalTotalNs = 0;
+    quint64 evalTotalCount = 0;
 };
 
 #endif // TEMPLATEINFOSENDER_H
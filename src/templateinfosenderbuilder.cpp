@@ -15,6 +15,7 @@
 #include "homeform.h"
 #include "tcpclientinfosender.h"
 #include "trainprogram.h"
+#include "dirconprocessor.h"
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -23,18 +24,41 @@ QHash<QString, TemplateInfoSenderBuilder *> TemplateInfoSenderBuilder::instanceM
 TemplateInfoSenderBuilder::TemplateInfoSenderBuilder(QObject *parent) : QObject(parent) {
     engine = new QJSEngine(this);
     engine->installExtensions(QJSEngine::AllExtensions);
+    templateSettings = new TemplateSettings(this);
     connect(&updateTimer, &QTimer::timeout, this, &TemplateInfoSenderBuilder::onUpdateTimeout);
     updateTimer.setSingleShot(false);
+    connect(&templateWatcher, &QFileSystemWatcher::fileChanged, this,
+            &TemplateInfoSenderBuilder::onTemplateFileChanged);
 }
 
 TemplateInfoSenderBuilder::~TemplateInfoSenderBuilder() { stop(); }
 
+QStringList TemplateSettings::keys() const {
+    if (cachedKeys.isEmpty()) {
+        cachedKeys = settings.allKeys();
+    }
+    return cachedKeys;
+}
+
+void TemplateSettings::setValue(const QString &key, const QVariant &value) {
+    if (!cachedKeys.isEmpty() && !settings.contains(key)) {
+        cachedKeys.append(key);
+    }
+    settings.setValue(key, value);
+}
+
 void TemplateInfoSenderBuilder::onUpdateTimeout() {
     buildContext();
     QHash<QString, TemplateInfoSender *>::Iterator it;
     bool rv;
     for (it = templateInfoMap.begin(); it != templateInfoMap.end(); it++) {
-        rv = it.value()->update(engine);
+        if (it.value()->js() == TEMPLATE_WORKOUT_MESSAGE_SCRIPT) {
+            // the built-in web server message is the snapshot as it is: no need to run it in the JS engine
+            rv = it.value()->sendWorkout(snapshot);
+        } else {
+            exposeWorkout();
+            rv = it.value()->update(engine);
+        }
         if (!rv) {
             qDebug() << QStringLiteral("Error updating") << it.key() << QStringLiteral("template");
         }
@@ -155,12 +179,19 @@ void TemplateInfoSenderBuilder::load(const QString &idInfo, const QStringList &f
             settings.setValue(QStringLiteral("template_") + templateId + QStringLiteral("_enabled"), false);
         } else if (settings.value(QStringLiteral("template_") + templateId + QStringLiteral("_enabled"), false)
                        .toBool()) {
-            newTemplate(templateId, TEMPLATE_TYPE_WEBSERVER,
-                        QStringLiteral("JSON.stringify({msg: \"workout\", content: this.workout})"));
+            newTemplate(templateId, TEMPLATE_TYPE_WEBSERVER, TEMPLATE_WORKOUT_MESSAGE_SCRIPT);
         } else {
             qDebug() << QStringLiteral("Template") << templateId << QStringLiteral(" is disabled: not created");
         }
     }
+    if (!templateWatcher.files().isEmpty()) {
+        templateWatcher.removePaths(templateWatcher.files());
+    }
+    for (const QString &filePath : qAsConst(templateFilesList)) {
+        if (filePath != TEMPLATE_TYPE_WEBSERVER) {
+            templateWatcher.addPath(filePath);
+        }
+    }
     qDebug() << QStringLiteral("Setting template_ids") << templateFilesList.keys();
     settings.setValue(QStringLiteral("template_") + idInfo + QStringLiteral("_ids"),
                       QStringList(templateFilesList.keys()));
@@ -171,7 +202,9 @@ TemplateInfoSender *TemplateInfoSenderBuilder::newTemplate(const QString &id, co
     TemplateInfoSender *tempInfo = nullptr;
 #ifdef Q_HTTPSERVER
     if (tp == TEMPLATE_TYPE_WEBSERVER) {
-        tempInfo = new WebServerInfoSender(id, this);
+        WebServerInfoSender *webServer = new WebServerInfoSender(id, this);
+        webServer->setMetricsProvider([this]() { return metrics(); });
+        tempInfo = webServer;
     } else
 #endif
         if (tp == TEMPLATE_TYPE_TCPCLIENT) {
@@ -193,13 +226,34 @@ TemplateInfoSender *TemplateInfoSenderBuilder::newTemplate(const QString &id, co
 
 void TemplateInfoSenderBuilder::reinit() { load(masterId, foldersToLook); }
 
-void TemplateInfoSenderBuilder::clearSessionArray() {
-    int len = sessionArray.count();
-    for (int i = 0; i < len; i++) {
-        sessionArray.removeAt(0);
+void TemplateInfoSenderBuilder::onTemplateFileChanged(const QString &path) {
+    // editors often replace the file instead of writing it, so the watch has to be restored
+    if (QFile::exists(path) && !templateWatcher.files().contains(path)) {
+        templateWatcher.addPath(path);
+    }
+    QFile f(path);
+    if (!f.open(QFile::ReadOnly | QFile::Text)) {
+        return;
+    }
+    QTextStream in(&f);
+    QString content = in.readAll();
+    if (content.isEmpty()) {
+        return;
+    }
+    for (auto it = templateFilesList.constBegin(); it != templateFilesList.constEnd(); ++it) {
+        TemplateInfoSender *tempInfo;
+        if (it.value() == path && (tempInfo = templateInfoMap.value(it.key(), nullptr))) {
+            qDebug() << QStringLiteral("Template") << it.key() << QStringLiteral("changed: it will be recompiled");
+            tempInfo->setScript(content);
+        }
     }
 }
 
+void TemplateInfoSenderBuilder::clearSessionArray() {
+    sessionArray.clear();
+    sessionVersion++;
+}
+
 void TemplateInfoSenderBuilder::start(bluetoothdevice *dev) {
     device = nullptr;
     clearSessionArray();
@@ -213,7 +267,7 @@ QStringList TemplateInfoSenderBuilder::templateIdList() const { return templateF
 
 void TemplateInfoSenderBuilder::onGetSettings(const QJsonValue &val, TemplateInfoSender *tempSender) {
     QJsonObject outObj;
-    QStringList keys = settings.allKeys();
+    QStringList keys = templateSettings->keys();
     QJsonValue keys_req;
     QJsonArray keys_arr;
     QVariantList keys_to_retrieve;
@@ -226,20 +280,20 @@ void TemplateInfoSenderBuilder::onGetSettings(const QJsonValue &val, TemplateInf
             if (key.startsWith(QStringLiteral("$"))) {
                 outObj.insert(key, 1);
                 QRegExp regex(key.mid(1));
-                for (auto &keypresent : settings.allKeys()) {
+                for (auto &keypresent : qAsConst(keys)) {
                     if (regex.indexIn(keypresent) >= 0) {
-                        outObj.insert(keypresent, QJsonValue::fromVariant(settings.value(keypresent)));
+                        outObj.insert(keypresent, QJsonValue::fromVariant(templateSettings->value(keypresent)));
                     }
                 }
-            } else if (settings.contains(key)) {
-                outObj.insert(key, QJsonValue::fromVariant(settings.value(key)));
+            } else if (templateSettings->contains(key)) {
+                outObj.insert(key, QJsonValue::fromVariant(templateSettings->value(key)));
             } else {
                 outObj.insert(key, QJsonValue());
             }
         }
     } else {
-        for (auto &key : settings.allKeys()) {
-            outObj.insert(key, QJsonValue::fromVariant(settings.value(key)));
+        for (auto &key : qAsConst(keys)) {
+            outObj.insert(key, QJsonValue::fromVariant(templateSettings->value(key)));
         }
     }
     QJsonObject main;
@@ -377,29 +431,49 @@ void TemplateInfoSenderBuilder::onSetSettings(const QJsonValue &msgContent, Temp
     QVariant valConv;
     QVariant settingVal;
     QJsonObject outObj;
+    // only the values that have really changed are written and pushed to the clients
+    QJsonObject changedObj;
     for (auto &key : keys) {
-        if (settings.contains(key)) {
-            val = obj[key];
-            valConv = val.toVariant();
-            settingVal = settings.value(key);
+        val = obj[key];
+        valConv = val.toVariant();
+        if (templateSettings->contains(key)) {
+            settingVal = templateSettings->value(key);
             if (valConv.type() == settingVal.type()) {
-                settings.setValue(key, valConv);
+                if (valConv != settingVal) {
+                    templateSettings->setValue(key, valConv);
+                    changedObj.insert(key, val);
+                }
                 outObj.insert(key, val);
             } else {
                 outObj.insert(key, QJsonValue::fromVariant(settingVal));
             }
         } else {
-            val = obj[key];
-            settings.setValue(key, val.toVariant());
+            templateSettings->setValue(key, valConv);
+            changedObj.insert(key, val);
             outObj.insert(key, val);
         }
     }
-    settings.sync();
     QJsonObject main;
     main[QStringLiteral("msg")] = QStringLiteral("R_setsettings");
     main[QStringLiteral("content")] = outObj;
     QJsonDocument out(main);
     tempSender->send(out.toJson());
+    if (!changedObj.isEmpty()) {
+        templateSettings->sync();
+        emit settingsChanged();
+#ifdef Q_HTTPSERVER
+        // only the web pages know this message: the tcp client templates stream their own format
+        QJsonObject changed;
+        changed[QStringLiteral("msg")] = QStringLiteral("settingschanged");
+        changed[QStringLiteral("content")] = changedObj;
+        QString changedMsg = QString::fromUtf8(QJsonDocument(changed).toJson(QJsonDocument::Compact));
+        for (TemplateInfoSender *sender : qAsConst(templateInfoMap)) {
+            if (qobject_cast<WebServerInfoSender *>(sender)) {
+                sender->send(changedMsg);
+            }
+        }
+#endif
+    }
 }
 
 void TemplateInfoSenderBuilder::onLoadTrainingPrograms(const QJsonValue &msgContent, TemplateInfoSender *tempSender) {
@@ -470,11 +544,140 @@ void TemplateInfoSenderBuilder::onAppendActivityDescription(const QJsonValue &ms
 }
 
 void TemplateInfoSenderBuilder::onGetSessionArray(TemplateInfoSender *tempSender) {
-    QJsonObject main;
-    main[QStringLiteral("content")] = sessionArray;
-    main[QStringLiteral("msg")] = QStringLiteral("R_getsessionarray");
-    QJsonDocument out(main);
-    tempSender->send(out.toJson());
+    // the samples are already serialized: they are only joined
+    QByteArray out = QByteArrayLiteral("{\"msg\":\"R_getsessionarray\",\"content\":[");
+    for (int i = 0; i < sessionArray.size(); i++) {
+        if (i) {
+            out += ',';
+        }
+        out += sessionArray.at(i);
+    }
+    out += "]}";
+    tempSender->send(QString::fromUtf8(out));
+}
+
+void TemplateInfoSenderBuilder::onGetSessionHistory(const QJsonValue &msgContent, TemplateInfoSender *tempSender) {
+    // the samples are identified by their index in the session: the client asks for the samples after the last one
+    // it has got ("since"). If the session has been restarted in the meantime the whole history is sent ("reset").
+    // With "maxpoints" the samples are decimated keeping one every "step", plus the last one.
+    QJsonObject req = msgContent.toObject();
+    const int count = sessionArray.size();
+    int since = req[QStringLiteral("since")].toInt(0);
+    int maxPoints = req[QStringLiteral("maxpoints")].toInt(0);
+    bool reset = req[QStringLiteral("session")].toInt(sessionVersion) != sessionVersion || since < 0 || since > count;
+    if (reset) {
+        since = 0;
+    }
+    int step = 1;
+    if (maxPoints > 0 && count - since > maxPoints) {
+        step = (count - since + maxPoints - 1) / maxPoints;
+    }
+    QByteArray out = QByteArrayLiteral("{\"msg\":\"R_getsessionhistory\",\"content\":{\"session\":") +
+                     QByteArray::number(sessionVersion) + QByteArrayLiteral(",\"reset\":") +
+                     (reset ? QByteArrayLiteral("true") : QByteArrayLiteral("false")) +
+                     QByteArrayLiteral(",\"from\":") + QByteArray::number(since) + QByteArrayLiteral(",\"seq\":") +
+                     QByteArray::number(count) + QByteArrayLiteral(",\"step\":") + QByteArray::number(step) +
+                     QByteArrayLiteral(",\"samples\":[");
+    int i;
+    for (i = since; i < count; i += step) {
+        if (i != since) {
+            out += ',';
+        }
+        out += sessionArray.at(i);
+    }
+    if (i - step != count - 1 && count > since) {
+        out += ',';
+        out += sessionArray.at(count - 1);
+    }
+    out += "]}}";
+    tempSender->send(QString::fromUtf8(out));
+}
+
+static void metricHeader(QByteArray &out, const char *name, const char *type, const char *help) {
+    out += QByteArrayLiteral("# HELP ") + name + ' ' + help + QByteArrayLiteral("\n# TYPE ") + name + ' ' + type + '\n';
+}
+
+static void metricSample(QByteArray &out, const char *name, const QByteArray &labels, double value) {
+    out += name;
+    if (!labels.isEmpty()) {
+        out += '{' + labels + '}';
+    }
+    out += ' ';
+    if (qIsNaN(value)) {
+        out += "NaN";
+    } else if (qIsInf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        out += QByteArray::number(value, 'g', 12);
+    }
+    out += '\n';
+}
+
+static QByteArray metricLabel(const QString &value) {
+    QByteArray out = value.toUtf8();
+    out.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+    return out;
+}
+
+QByteArray TemplateInfoSenderBuilder::metrics() const {
+    // Prometheus text exposition format, built from the snapshot of the last update
+    static const struct {
+        const char *key;
+        const char *name;
+        const char *help;
+    } deviceGauges[] = {
+        {"watts", "qz_power_watts", "Current power."},
+        {"cadence", "qz_cadence_rpm", "Current cadence."},
+        {"heart", "qz_heart_rate_bpm", "Current heart rate."},
+        {"speed", "qz_speed_kmh", "Current speed."},
+        {"resistance", "qz_resistance", "Current resistance level."},
+        {"inclination", "qz_inclination_percent", "Current inclination."},
+        {"distance", "qz_distance_km", "Distance of the workout."},
+        {"calories", "qz_calories_kcal", "Calories of the workout."},
+        {"deviceRSSI", "qz_device_rssi_dbm", "Bluetooth signal strength of the device."},
+    };
+    QByteArray out;
+    QJsonObject workout = snapshot.toJsonObject();
+    QByteArray labels;
+    if (!snapshot.isEmpty()) {
+        labels = QByteArrayLiteral("device=\"") + metricLabel(workout[QStringLiteral("deviceName")].toString()) +
+                 QByteArrayLiteral("\",type=\"") + QByteArray::number(workout[QStringLiteral("deviceType")].toInt()) +
+                 '"';
+    }
+    metricHeader(out, "qz_device_connected", "gauge", "Whether the fitness device is connected.");
+    metricSample(out, "qz_device_connected", labels, workout[QStringLiteral("deviceConnected")].toBool() ? 1 : 0);
+    metricHeader(out, "qz_device_paused", "gauge", "Whether the workout is paused.");
+    metricSample(out, "qz_device_paused", labels, workout[QStringLiteral("devicePaused")].toBool() ? 1 : 0);
+    for (const auto &gauge : deviceGauges) {
+        QJsonValue value = workout.value(QLatin1String(gauge.key));
+        if (value.isDouble()) {
+            metricHeader(out, gauge.name, "gauge", gauge.help);
+            metricSample(out, gauge.name, labels, value.toDouble());
+        }
+    }
+    if (!snapshot.isEmpty()) {
+        metricHeader(out, "qz_elapsed_seconds", "gauge", "Elapsed time of the workout.");
+        metricSample(out, "qz_elapsed_seconds", labels,
+                     workout[QStringLiteral("elapsed_h")].toInt() * 3600 +
+                         workout[QStringLiteral("elapsed_m")].toInt() * 60 +
+                         workout[QStringLiteral("elapsed_s")].toInt());
+    }
+    metricHeader(out, "qz_session_samples", "gauge", "Samples in the session history of the templates.");
+    metricSample(out, "qz_session_samples", QByteArray(), sessionArray.size());
+    metricHeader(out, "qz_dircon_clients", "gauge", "Clients connected to the DirCon servers.");
+    metricSample(out, "qz_dircon_clients", QByteArray(), DirconProcessor::connectedClients());
+
+    metricHeader(out, "qz_template_eval_seconds_total", "counter", "Time spent running the template scripts.");
+    for (auto it = templateInfoMap.constBegin(); it != templateInfoMap.constEnd(); ++it) {
+        metricSample(out, "qz_template_eval_seconds_total",
+                     QByteArrayLiteral("template=\"") + metricLabel(it.key()) + '"', it.value()->evalTimeNs() / 1e9);
+    }
+    metricHeader(out, "qz_template_evals_total", "counter", "Runs of the template scripts.");
+    for (auto it = templateInfoMap.constBegin(); it != templateInfoMap.constEnd(); ++it) {
+        metricSample(out, "qz_template_evals_total", QByteArrayLiteral("template=\"") + metricLabel(it.key()) + '"',
+                     it.value()->evalCount());
+    }
+    return out;
 }
 
 void TemplateInfoSenderBuilder::onGetGPXBase64(TemplateInfoSender *tempSender) {
@@ -716,6 +919,9 @@ void TemplateInfoSenderBuilder::onDataReceived(const QByteArray &data) {
                 } else if (msg == QStringLiteral("getsessionarray")) {
                     onGetSessionArray(sender);
                     return;
+                } else if (msg == QStringLiteral("getsessionhistory")) {
+                    onGetSessionHistory(jsonObject[QStringLiteral("content")], sender);
+                    return;
                 }
                 if (msg == QStringLiteral("start")) {
                     onStart(sender);
@@ -745,33 +951,57 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         obj = glob.property(QStringLiteral("workout"));
 
     if (!glob.hasOwnProperty(QStringLiteral("settings")) || forceReinit) {
-        QJSValue sett = engine->newObject();
-        glob.setProperty(QStringLiteral("settings"), sett);
-        QVariant::Type typesett;
-        QVariant valsett;
-        int i = 0;
-        auto allKeys_list = settings.allKeys();
-        for (const auto &key : allKeys_list) {
-            valsett.setValue(settings.value(key));
-            typesett = valsett.type();
-            if (typesett == QVariant::Int) {
-                sett.setProperty(key, valsett.toInt());
-            } else if (typesett == QVariant::Double) {
-                sett.setProperty(key, valsett.toDouble());
-            } else if (typesett == QVariant::String) {
-                sett.setProperty(key, valsett.toString());
-            } else if (typesett == QVariant::Bool) {
-                sett.setProperty(key, valsett.toBool());
-            } else if (typesett == QVariant::UInt) {
-                sett.setProperty(key, valsett.toUInt());
-            } else if (typesett == QVariant::StringList) {
-                QStringList settL = valsett.toStringList();
-                QJSValue settLJ = engine->newArray(settL.size());
-                i = 0;
-                for (const auto &settLK : qAsConst(settL)) {
-                    settLJ.setProperty(i++, settLK);
+        templateSettings->invalidate();
+        // the values are read from the settings only when a script reads them
+        QJSValue settingsProxy = engine->evaluate(QStringLiteral(
+            "(function(accessor) {\n"
+            "    return new Proxy({}, {\n"
+            "        get: function(target, key) {\n"
+            "            return typeof key === 'string' ? accessor.value(key) : undefined;\n"
+            "        },\n"
+            "        has: function(target, key) { return accessor.contains(key); },\n"
+            "        ownKeys: function(target) { return accessor.keys(); },\n"
+            "        getOwnPropertyDescriptor: function(target, key) {\n"
+            "            return accessor.contains(key) ?\n"
+            "                {value: accessor.value(key), enumerable: true, configurable: true} : undefined;\n"
+            "        }\n"
+            "    });\n"
+            "})"));
+        if (settingsProxy.isCallable()) {
+            settingsProxy = settingsProxy.call(QJSValueList() << engine->newQObject(templateSettings));
+        }
+        if (!settingsProxy.isError() && settingsProxy.isObject()) {
+            glob.setProperty(QStringLiteral("settings"), settingsProxy);
+        } else {
+            // old JS engines without Proxy: all the settings are copied
+            QJSValue sett = engine->newObject();
+            glob.setProperty(QStringLiteral("settings"), sett);
+            QVariant::Type typesett;
+            QVariant valsett;
+            int i = 0;
+            auto allKeys_list = settings.allKeys();
+            for (const auto &key : allKeys_list) {
+                valsett.setValue(settings.value(key));
+                typesett = valsett.type();
+                if (typesett == QVariant::Int) {
+                    sett.setProperty(key, valsett.toInt());
+                } else if (typesett == QVariant::Double) {
+                    sett.setProperty(key, valsett.toDouble());
+                } else if (typesett == QVariant::String) {
+                    sett.setProperty(key, valsett.toString());
+                } else if (typesett == QVariant::Bool) {
+                    sett.setProperty(key, valsett.toBool());
+                } else if (typesett == QVariant::UInt) {
+                    sett.setProperty(key, valsett.toUInt());
+                } else if (typesett == QVariant::StringList) {
+                    QStringList settL = valsett.toStringList();
+                    QJSValue settLJ = engine->newArray(settL.size());
+                    i = 0;
+                    for (const auto &settLK : qAsConst(settL)) {
+                        settLJ.setProperty(i++, settLK);
+                    }
+                    sett.setProperty(key, settLJ);
                 }
-                sett.setProperty(key, settLJ);
             }
         }
         obj.setProperty(QStringLiteral("BIKE_TYPE"), (int)bluetoothdevice::BIKE);
@@ -780,110 +1010,21 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         obj.setProperty(QStringLiteral("TREADMILL_TYPE"), (int)bluetoothdevice::TREADMILL);
         obj.setProperty(QStringLiteral("UNKNOWN_TYPE"), (int)bluetoothdevice::UNKNOWN);
     }
-    if (!device) {
-        obj.setProperty(QStringLiteral("deviceId"), QJSValue());
-    } else {
-        QTime el = device->elapsedTime();
-        QString name;
-        QString nickName;
-        bluetoothdevice::BLUETOOTH_TYPE tp = device->deviceType();
+    snapshot.capture(device, settings.value(QZSettings::user_nickname, QZSettings::default_user_nickname).toString(),
+                     workoutName, workoutStartDate, instructorName);
+    workoutExposed = false;
+    if (device && !snapshot.paused()) {
+        sessionArray.append(snapshot.json());
+    }
+}
 
-        metric dep;
-#ifdef Q_OS_IOS
-        obj.setProperty("deviceId", device->bluetoothDevice.deviceUuid().toString());
-#else
-        obj.setProperty(QStringLiteral("deviceId"), device->bluetoothDevice.address().toString());
-#endif
-        obj.setProperty(QStringLiteral("deviceName"),
-                        (name = device->bluetoothDevice.name()).isEmpty() ? QString(QStringLiteral("N/A")) : name);
-        obj.setProperty(QStringLiteral("deviceRSSI"), device->bluetoothDevice.rssi());
-        obj.setProperty(QStringLiteral("deviceType"), (int)device->deviceType());
-        obj.setProperty(QStringLiteral("deviceConnected"), (bool)device->connected());
-        obj.setProperty(QStringLiteral("devicePaused"), (bool)device->isPaused());
-        obj.setProperty(QStringLiteral("elapsed_s"), el.second());
-        obj.setProperty(QStringLiteral("elapsed_m"), el.minute());
-        obj.setProperty(QStringLiteral("elapsed_h"), el.hour());
-        el = device->currentPace();
-        obj.setProperty(QStringLiteral("pace_s"), el.second());
-        obj.setProperty(QStringLiteral("pace_m"), el.minute());
-        obj.setProperty(QStringLiteral("pace_h"), el.hour());
-        el = device->movingTime();
-        obj.setProperty(QStringLiteral("moving_s"), el.second());
-        obj.setProperty(QStringLiteral("moving_m"), el.minute());
-        obj.setProperty(QStringLiteral("moving_h"), el.hour());
-        obj.setProperty(QStringLiteral("speed"), (dep = device->currentSpeed()).value());
-        obj.setProperty(QStringLiteral("speed_avg"), dep.average());
-        obj.setProperty(QStringLiteral("calories"), device->calories().value());
-        obj.setProperty(QStringLiteral("distance"), device->odometer());
-        obj.setProperty(QStringLiteral("heart"), (dep = device->currentHeart()).value());
-        obj.setProperty(QStringLiteral("heart_avg"), dep.average());
-        obj.setProperty(QStringLiteral("heart_max"), dep.max());
-        obj.setProperty(QStringLiteral("jouls"), device->jouls().value());
-        obj.setProperty(QStringLiteral("elevation"), device->elevationGain().value());
-        obj.setProperty(QStringLiteral("difficult"), device->difficult());
-        obj.setProperty(QStringLiteral("watts"), (dep = device->wattsMetric()).value());
-        obj.setProperty(QStringLiteral("watts_avg"), dep.average());
-        obj.setProperty(QStringLiteral("watts_max"), dep.max());
-        obj.setProperty(QStringLiteral("kgwatts"), (dep = device->wattKg()).value());
-        obj.setProperty(QStringLiteral("kgwatts_avg"), dep.average());
-        obj.setProperty(QStringLiteral("kgwatts_max"), dep.max());
-        obj.setProperty(QStringLiteral("workoutName"), workoutName);
-        obj.setProperty(QStringLiteral("workoutStartDate"), workoutStartDate);
-        obj.setProperty(QStringLiteral("instructorName"), instructorName);
-        obj.setProperty(QStringLiteral("latitude"), device->currentCordinate().latitude());
-        obj.setProperty(QStringLiteral("longitude"), device->currentCordinate().longitude());
-        obj.setProperty(QStringLiteral("altitude"), device->currentCordinate().altitude());
-        obj.setProperty(
-            QStringLiteral("nickName"),
-            (nickName = settings.value(QZSettings::user_nickname, QZSettings::default_user_nickname).toString()).isEmpty()
-                ? QString(QStringLiteral("N/A"))
-                : nickName);
-        if (tp == bluetoothdevice::BIKE) {
-            obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((bike *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedPelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((bike *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((bike *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cranks"), ((bike *)device)->currentCrankRevolutions());
-            obj.setProperty(QStringLiteral("cranktime"), ((bike *)device)->lastCrankEventTime());
-            obj.setProperty(QStringLiteral("req_power"), (dep = ((bike *)device)->lastRequestedPower()).value());
-            obj.setProperty(QStringLiteral("req_cadence"), (dep = ((bike *)device)->lastRequestedCadence()).value());
-            obj.setProperty(QStringLiteral("req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedResistance()).value());
-        } else if (tp == bluetoothdevice::ROWING) {
-            obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((rower *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((rower *)device)->currentCadence()).value());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((rower *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cranks"), ((rower *)device)->currentCrankRevolutions());
-            obj.setProperty(QStringLiteral("cranktime"), ((rower *)device)->lastCrankEventTime());
-            obj.setProperty(QStringLiteral("strokescount"), ((rower *)device)->currentStrokesCount().value());
-            obj.setProperty(QStringLiteral("strokeslength"), ((rower *)device)->currentStrokesLength().value());
-        } else if (tp == bluetoothdevice::TREADMILL) {
-            obj.setProperty(QStringLiteral("inclination"), (dep = ((treadmill *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
-            obj.setProperty(QStringLiteral("stridelength"),
-                            (dep = ((treadmill *)device)->currentStrideLength()).value());
-            obj.setProperty(QStringLiteral("groundcontact"),
-                            (dep = ((treadmill *)device)->currentGroundContact()).value());
-            obj.setProperty(QStringLiteral("verticaloscillation"),
-                            (dep = ((treadmill *)device)->currentVerticalOscillation()).value());
-        } else if (tp == bluetoothdevice::ELLIPTICAL) {
-            obj.setProperty(QStringLiteral("inclination"),
-                            (dep = ((elliptical *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
-        }
-        if (!device->isPaused()) {
-            sessionArray.append(QJsonObject::fromVariantMap(obj.toVariant().toMap()));
-        }
+void TemplateInfoSenderBuilder::exposeWorkout() {
+    if (workoutExposed) {
+        return;
     }
+    QJSValue obj = engine->globalObject().property(QStringLiteral("workout"));
+    snapshot.fillJSValue(obj);
+    workoutExposed = true;
 }
 
 void TemplateInfoSenderBuilder::workoutEventStateChanged(bluetoothdevice::WORKOUT_EVENT_STATE state) {
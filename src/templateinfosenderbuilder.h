@@ -2,6 +2,8 @@
 #define TEMPLATEINFOSENDERBUILDER_H
 #include "bluetoothdevice.h"
 #include "templateinfosender.h"
+#include "workoutsnapshot.h"
+#include <QFileSystemWatcher>
 #include <QHash>
 #include <QJSEngine>
 #include <QJsonArray>
@@ -10,6 +12,28 @@
 #define TEMPLATE_TYPE_TCPCLIENT QStringLiteral("TcpClient")
 #define TEMPLATE_TYPE_WEBSERVER QStringLiteral("WebServer")
 #define TEMPLATE_PRIVATE_WEBSERVER_ID "QZWS"
+#define TEMPLATE_WORKOUT_MESSAGE_SCRIPT QStringLiteral("JSON.stringify({msg: \"workout\", content: this.workout})")
+
+/**
+ * @brief Read access to the settings for the template scripts. The "settings" JS object is a Proxy on this object,
+ * so a value is read only when a script asks for it instead of copying all the settings in the JS context.
+ */
+class TemplateSettings : public QObject {
+    Q_OBJECT
+  public:
+    explicit TemplateSettings(QObject *parent = nullptr) : QObject(parent) {}
+    Q_INVOKABLE QVariant value(const QString &key) const { return settings.value(key); }
+    Q_INVOKABLE bool contains(const QString &key) const { return settings.contains(key); }
+    Q_INVOKABLE QStringList keys() const;
+    void setValue(const QString &key, const QVariant &value);
+    void sync() { settings.sync(); }
+    void invalidate() { cachedKeys.clear(); }
+
+  private:
+    QSettings settings;
+    // allKeys() walks all the settings, it is read again only after invalidate() or when a key is added
+    mutable QStringList cachedKeys;
+};
 
 class TemplateInfoSenderBuilder : public QObject {
     Q_OBJECT
@@ -20,14 +44,21 @@ class TemplateInfoSenderBuilder : public QObject {
     void start(bluetoothdevice *device);
     void stop();
     QStringList templateIdList() const;
+    /**
+     * @brief The device values and the internal counters in the Prometheus text format, see the /metrics route.
+     */
+    QByteArray metrics() const;
     ~TemplateInfoSenderBuilder();
   signals:
     void activityDescriptionChanged(QString newDescription);
     void chartSaved(QString filename);
+    // a template wrote the settings with setsettings
+    void settingsChanged();
 
   private:
     bool validFileTemplateType(const QString &tp) const;
     void buildContext(bool forceReinit = false);
+    void exposeWorkout();
     QString activityDescription;
     void createTemplatesFromFolder(const QString &idInfo, const QString &folder, QStringList &dirTemplates);
     void clearSessionArray();
@@ -35,9 +66,16 @@ class TemplateInfoSenderBuilder : public QObject {
     QTimer updateTimer;
     QString masterId;
     QStringList foldersToLook;
-    QJsonArray sessionArray;
+    WorkoutSnapshot snapshot;
+    // true when the snapshot of this tick has been copied in the "workout" JS object
+    bool workoutExposed = false;
+    // compact JSON of every sample of the session
+    QList<QByteArray> sessionArray;
+    // changed every time the session is cleared, see onGetSessionHistory
+    int sessionVersion = 0;
     QHash<QString, QVariant> context;
     QJSEngine *engine = nullptr;
+    TemplateSettings *templateSettings = nullptr;
     TemplateInfoSenderBuilder(QObject *parent);
     void load(const QString &idInfo, const QStringList &folders);
     static QHash<QString, TemplateInfoSenderBuilder *> instanceMap;
@@ -45,6 +83,7 @@ class TemplateInfoSenderBuilder : public QObject {
     QHash<QString, TemplateInfoSender *> templateInfoMap;
     TemplateInfoSender *newTemplate(const QString &id, const QString &tp, const QString &dataTempl);
     QHash<QString, QString> templateFilesList;
+    QFileSystemWatcher templateWatcher;
     void onSetSettings(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onGetSettings(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onSetResistance(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
@@ -58,6 +97,7 @@ class TemplateInfoSenderBuilder : public QObject {
     void onLoadTrainingPrograms(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onAppendActivityDescription(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onGetSessionArray(TemplateInfoSender *tempSender);
+    void onGetSessionHistory(const QJsonValue &msgContent, TemplateInfoSender *tempSender);
     void onGetLatLon(TemplateInfoSender *tempSender);
     void onNextInclination300Meters(TemplateInfoSender *tempSender);
     void onGetGPXBase64(TemplateInfoSender *tempSender);
@@ -70,6 +110,7 @@ class TemplateInfoSenderBuilder : public QObject {
   private slots:
     void onUpdateTimeout();
     void onDataReceived(const QByteArray &data);
+    void onTemplateFileChanged(const QString &path);
   public slots:
     void onWorkoutNameChanged(QString name) { workoutName = name; }
     void onWorkoutStartDate(QString name) { workoutStartDate = name; }
@@ -1,4 +1,5 @@
 #include "trainprogram.h"
+#include "routesimulator.h"
 #include "zwiftworkout.h"
 #include <QFile>
 #include <QMutexLocker>
@@ -43,6 +44,7 @@ trainprogram::trainprogram(const QList<trainrow> &rows, bluetooth *b, QString *d
         QTime(0, 0, 0).secsTo(rows.at(0).gpxElapsed) != 0 && !treadmill_force_speed && videoAvailable) {
         applySpeedFilter();
     }
+    buildTimeline();
 
     connect(&timer, SIGNAL(timeout()), this, SLOT(scheduler()));
     timer.setInterval(1s);
@@ -148,6 +150,12 @@ void trainprogram::applySpeedFilter() {
     for (r = 0; r < rows.length(); r++) {
         rows[r].distance = newdistance.at(r);
     }
+    buildTimeline();
+}
+
+void trainprogram::buildTimeline() {
+    QSettings settings;
+    timeline = trainprogramtimeline(rows, settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble());
 }
 
 uint32_t trainprogram::calculateTimeForRow(int32_t row) {
@@ -305,20 +313,33 @@ double trainprogram::TimeRateFromGPX(double gpxsecs, double videosecs, double cu
     return rate;
 }
 
-double trainprogram::avgInclinationNext100Meters() {
-    int c = currentStep;
+double trainprogram::avgInclinationNext100Meters(double aheadMeters) {
+    int start = currentStep;
+    double startDistance = currentStepDistance;
+    double ahead = aheadMeters / 1000.0;
+
+    // the position on the route after aheadMeters
+    while (ahead > 0 && start + 1 < rows.length() && rows.at(start).distance - startDistance <= ahead) {
+        ahead -= rows.at(start).distance - startDistance;
+        start++;
+        startDistance = 0;
+    }
+    if (ahead > 0)
+        startDistance = qMin(startDistance + ahead, qMax(rows.at(start).distance, 0.0));
+
+    int c = start;
     double km = 0;
     double avg = 0;
     int sum = 0;
-    double startingAltitude = rows.at(currentStep).altitude;
+    double startingAltitude = rows.at(start).altitude;
 
     while (1) {
         if (c < rows.length()) {
             if (km > 0.1) {
                 return avg / (double)sum;
             }
-            if (c == currentStep)
-                km += (rows.at(c).distance - currentStepDistance);
+            if (c == start)
+                km += (rows.at(c).distance - startDistance);
             else
                 km += (rows.at(c).distance);
             avg += (rows.at(c).altitude - startingAltitude);
@@ -332,6 +353,51 @@ double trainprogram::avgInclinationNext100Meters() {
     return avg / (double)sum;
 }
 
+// the inclination to request now, so that the device reaches it when the user gets there: the lead time of the
+// inclination actuator (dead time and slew rate) is converted in meters with the current speed
+double trainprogram::predictedInclination(double inclination, double rowRemainingSeconds) {
+    QSettings settings;
+    bluetoothdevice *device = bluetoothManager->device();
+    if (!device ||
+        !settings.value(QZSettings::inclination_predictive, QZSettings::default_inclination_predictive).toBool()) {
+        lastPredictedInclination = inclination;
+        return inclination;
+    }
+
+    const inclinationactuator &actuator = device->inclinationActuator();
+    double current = device->currentInclination().value();
+    double metersPerSecond = device->currentSpeed().value() / 3.6;
+    double predicted = inclination;
+
+    // the lead time depends on the target, two iterations are enough for the prediction to settle
+    if (!isnan(rows.at(currentStep).latitude) && !isnan(rows.at(currentStep).longitude)) {
+        for (int i = 0; i < 2; i++)
+            predicted = avgInclinationNext100Meters(metersPerSecond * actuator.leadTime(current, predicted));
+    } else if (rows.at(currentStep).distance > 0) {
+        QList<MetersByInclination> next = inclinationNext300Meters();
+        for (int i = 0; i < 2; i++) {
+            double ahead = metersPerSecond * actuator.leadTime(current, predicted);
+            double meters = 0;
+            predicted = inclination;
+            for (int j = 0; j < next.length() && meters <= ahead; j++) {
+                if (j > 0 && next.at(j).inclination != -200)
+                    predicted = next.at(j).inclination;
+                meters += next.at(j).meters;
+            }
+        }
+    } else if (currentStep + 1 < rows.length() && rows.at(currentStep + 1).inclination != -200) {
+        double next = rows.at(currentStep + 1).inclination;
+        if (rowRemainingSeconds <= actuator.leadTime(current, next))
+            predicted = next;
+    }
+
+    if (predicted != inclination)
+        qDebug() << QStringLiteral("trainprogram predicted inclination") << inclination << predicted
+                 << actuator.deadTime() << actuator.slewRate();
+    lastPredictedInclination = predicted;
+    return predicted;
+}
+
 double trainprogram::avgAzimuthNext300Meters() {
     int c = currentStep;
     double km = 0;
@@ -378,6 +444,7 @@ double trainprogram::avgAzimuthNext300Meters() {
 void trainprogram::clearRows() {
     QMutexLocker(&this->schedulerMutex);
     rows.clear();
+    buildTimeline();
 }
 
 void trainprogram::scheduler() {
@@ -412,6 +479,7 @@ void trainprogram::scheduler() {
                 } else {
                     inc = rows.at(0).inclination;
                 }
+                inc = predictedInclination(inc, (double)calculateTimeForRow(0) - ticks);
                 qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                 emit changeInclination(inc, inc);
                 emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -452,6 +520,7 @@ void trainprogram::scheduler() {
                                                              bikeResistanceOffset + 1); // resistance start from 1)
                 if (!((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
                     bluetoothManager->device()->setInclination(inc);
+                inc = predictedInclination(inc, (double)calculateTimeForRow(0) - ticks);
                 qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                 emit changeInclination(inc, inc);
                 emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -479,16 +548,11 @@ void trainprogram::scheduler() {
     qDebug() << QStringLiteral("trainprogram elapsed ") + QString::number(ticks) + QStringLiteral("current row len") +
                     QString::number(currentRowLen);
 
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-        calculatedElapsedTime += calculateTimeForRow(calculatedLine);
-
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-            break;
-        }
-    }
+    uint32_t calculatedLine = timeline.rowAt(static_cast<uint32_t>(ticks));
+    uint32_t calculatedElapsedTime = timeline.end(calculatedLine);
+    double rowRemainingSeconds = (double)calculatedElapsedTime - ticks;
+    bool inclinationPredictive =
+        settings.value(QZSettings::inclination_predictive, QZSettings::default_inclination_predictive).toBool();
 
     bool distanceEvaluation = false;
     int sameIteration = 0;
@@ -533,6 +597,7 @@ void trainprogram::scheduler() {
                         } else {
                             inc = rows.at(currentStep).inclination;
                         }
+                        inc = predictedInclination(inc, rowRemainingSeconds);
                         qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                         emit changeInclination(inc, inc);
                         emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -580,6 +645,7 @@ void trainprogram::scheduler() {
                                                                      1); // resistance start from 1)
                         if (!((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
                             bluetoothManager->device()->setInclination(inc);
+                        inc = predictedInclination(inc, rowRemainingSeconds);
                         qDebug() << QStringLiteral("trainprogram change inclination") + QString::number(inc);
                         emit changeInclination(inc, inc);
                         emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -661,6 +727,7 @@ void trainprogram::scheduler() {
                     if (!((bike *)bluetoothManager->device())->inclinationAvailableByHardware())
                         bluetoothManager->device()->setInclination(inc);
                 }
+                inc = predictedInclination(inc, rowRemainingSeconds);
                 qDebug() << QStringLiteral("trainprogram change inclination due to gps") + QString::number(inc);
                 emit changeInclination(inc, inc);
                 emit changeNextInclination300Meters(inclinationNext300Meters());
@@ -690,6 +757,16 @@ void trainprogram::scheduler() {
                          << distanceRow << currentStepDistance << lastCurrentStepDistance << ratioDistance
                          << rows.at(currentStep).gpxElapsed << lastCurrentStepTime << ticks;
                 emit changeTimestamp(lastCurrentStepTime, QTime(0, 0, 0).addSecs(ticks));
+            } else if (inclinationPredictive && rows.at(currentStep).inclination != -200 &&
+                       (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL ||
+                        bluetoothManager->device()->deviceType() == bluetoothdevice::BIKE)) {
+                // the next row is close enough that the device has to start moving now
+                double previous = lastPredictedInclination;
+                double inc = predictedInclination(rows.at(currentStep).inclination, rowRemainingSeconds);
+                if (inc != previous) {
+                    qDebug() << QStringLiteral("trainprogram change inclination ahead") + QString::number(inc);
+                    emit changeInclination(inc, inc);
+                }
             }
         }
         sameIteration++;
@@ -717,6 +794,7 @@ void trainprogram::restart() {
     ticks = 0;
     offset = 0;
     currentStep = 0;
+    remainingStep = -1;
     started = true;
 }
 
@@ -927,49 +1005,39 @@ trainrow trainprogram::currentRow() {
     return trainrow();
 }
 
-trainrow trainprogram::getRowFromCurrent(uint32_t offset) {
+const trainrow &trainprogram::getRowFromCurrent(uint32_t offset) {
+    static const trainrow empty;
     if (started && !rows.isEmpty() && (currentStep + offset) < (uint32_t)rows.length()) {
         return rows.at(currentStep + offset);
     }
-    return trainrow();
+    return empty;
+}
+
+uint8_t trainprogram::zoneFromCurrent(uint32_t offset) {
+    if (started && (currentStep + offset) < (uint32_t)timeline.count()) {
+        return timeline.zone(currentStep + offset);
+    }
+    return 0;
 }
 
 double trainprogram::currentTargetMets() {
-    if (currentRow().mets)
-        return currentRow().mets;
+    const trainrow &row = getRowFromCurrent(0);
+    if (row.mets)
+        return row.mets;
     else
         return 0;
 }
 
 QTime trainprogram::currentRowElapsedTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
+    int calculatedLine = timeline.rowAt(static_cast<uint32_t>(ticks));
 
-    if (rows.length() == 0)
+    if (calculatedLine >= timeline.count())
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-        uint32_t currentLine = calculateTimeForRow(calculatedLine);
-        calculatedElapsedTime += currentLine;
-        uint32_t rampElapsed = 0;
-
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-            if (rows.at(calculatedLine).rampElapsed != QTime(0, 0, 0)) {
-                rampElapsed = (rows.at(calculatedLine).rampElapsed.second() +
-                               (rows.at(calculatedLine).rampElapsed.minute() * 60) +
-                               (rows.at(calculatedLine).rampElapsed.hour() * 3600));
-            }
-            return QTime(0, 0, 0).addSecs(rampElapsed + ticks - (calculatedElapsedTime - currentLine));
-        }
-    }
-    return QTime(0, 0, 0);
+    return QTime(0, 0, 0).addSecs(timeline.rampElapsed(calculatedLine) + ticks - timeline.start(calculatedLine));
 }
 
 QTime trainprogram::currentRowRemainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
@@ -982,49 +1050,54 @@ QTime trainprogram::currentRowRemainingTime() {
         int hours = seconds / 3600;
         return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
     } else {
-        for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-            uint32_t currentLine = calculateTimeForRow(calculatedLine);
-            calculatedElapsedTime += currentLine;
-
-            if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-                if (rows.at(calculatedLine).rampDuration != QTime(0, 0, 0)) {
-                    calculatedElapsedTime += ((rows.at(calculatedLine).rampDuration.second() +
-                                               (rows.at(calculatedLine).rampDuration.minute() * 60) +
-                                               (rows.at(calculatedLine).rampDuration.hour() * 3600))) -
-                                             1;
-                }
-                int seconds = calculatedElapsedTime - ticks;
-                int hours = seconds / 3600;
-                return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
+        int calculatedLine = timeline.rowAt(static_cast<uint32_t>(ticks));
+        if (calculatedLine < timeline.count()) {
+            uint32_t calculatedElapsedTime = timeline.end(calculatedLine);
+            if (timeline.rampDuration(calculatedLine)) {
+                calculatedElapsedTime += timeline.rampDuration(calculatedLine) - 1;
             }
+            int seconds = calculatedElapsedTime - ticks;
+            int hours = seconds / 3600;
+            return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
         }
     }
     return QTime(0, 0, 0);
 }
 
 QTime trainprogram::remainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedTotalTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-        calculatedTotalTime += calculateTimeForRow(calculatedLine);
+    // the rows by distance (routes) have no duration: the time to the end at the average power or speed so far
+    if (currentStep < rows.length() && rows.at(currentStep).distance > 0 && bluetoothManager &&
+        bluetoothManager->device()) {
+        bluetoothdevice *device = bluetoothManager->device();
+        bool bike = device->deviceType() == bluetoothdevice::BIKE;
+        double average = bike ? device->wattsMetric().average() : device->currentSpeed().average();
+        if (currentStep != remainingStep || qAbs(average - remainingAverage) > remainingAverage * 0.02) {
+            // the whole current row, the part already done is removed below
+            remainingSimulation = bike ? routesimulator().simulate(rows, average, 0, currentStep)
+                                       : routesimulator().simulate(rows, 0, average, currentStep);
+            remainingStep = currentStep;
+            remainingAverage = average;
+            // no average yet, or a row by distance too slow to end: the timeline is the only estimate
+            remainingKnown = average > 0 && !remainingSimulation.isEmpty();
+            for (int i = 0; i < remainingSimulation.length() && remainingKnown; i++)
+                if (rows.at(currentStep + i).distance > 0 && remainingSimulation.at(i).speed < routesimulator::minSpeed)
+                    remainingKnown = false;
+        }
+        if (remainingKnown) {
+            const routesimulator::row &first = remainingSimulation.first();
+            double done = first.distance > 0 ? qMin(1.0, currentStepDistance / first.distance) : 0;
+            return QTime(0, 0, 0).addSecs(qRound(routesimulator::duration(remainingSimulation) - first.seconds * done));
+        }
     }
-    return QTime(0, 0, 0).addSecs(calculatedTotalTime - ticks);
-}
-
-QTime trainprogram::duration() {
 
-    QTime total(0, 0, 0, 0);
-    for (const trainrow &row : qAsConst(rows)) {
-        total = total.addSecs((row.duration.hour() * 3600) + (row.duration.minute() * 60) + row.duration.second());
-    }
-    return total;
+    return QTime(0, 0, 0).addSecs(timeline.total() - ticks);
 }
 
+QTime trainprogram::duration() { return QTime(0, 0, 0, 0).addSecs(timeline.duration()); }
+
 double trainprogram::totalDistance() {
 
     double distance = 0;
@@ -1,6 +1,8 @@
 #ifndef TRAINPROGRAM_H
 #define TRAINPROGRAM_H
 #include "bluetooth.h"
+#include "routesimulator.h"
+#include "trainprogramtimeline.h"
 #include <QGeoCoordinate>
 #include <QMutex>
 #include <QObject>
@@ -68,7 +70,9 @@ class trainprogram : public QObject {
     QTime duration();
     double totalDistance();
     trainrow currentRow();
-    trainrow getRowFromCurrent(uint32_t offset);
+    const trainrow &getRowFromCurrent(uint32_t offset);
+    // the power zone of the target of a row, 0 without power target
+    uint8_t zoneFromCurrent(uint32_t offset);
     void increaseElapsedTime(uint32_t i);
     void decreaseElapsedTime(uint32_t i);
     int32_t offsetElapsedTime() { return offset; }
@@ -113,10 +117,20 @@ class trainprogram : public QObject {
     mutable QRecursiveMutex schedulerMutex;
     double avgAzimuthNext300Meters();
     QList<MetersByInclination> inclinationNext300Meters();
-    double avgInclinationNext100Meters();
+    // aheadMeters moves the start of the 100 meters forward from the current position
+    double avgInclinationNext100Meters(double aheadMeters = 0);
+    double predictedInclination(double inclination, double rowRemainingSeconds);
     uint32_t calculateTimeForRow(int32_t row);
     uint32_t calculateTimeForRowMergingRamps(int32_t row);
     double calculateDistanceForRow(int32_t row);
+    // to be rebuilt every time the durations or the distances of the rows change
+    void buildTimeline();
+    trainprogramtimeline timeline;
+    // remainingTime() of the rows by distance, simulated again only on a new row or on a new average
+    QVector<routesimulator::row> remainingSimulation;
+    int32_t remainingStep = -1;
+    double remainingAverage = 0;
+    bool remainingKnown = false;
     bluetooth *bluetoothManager;
     bool started = false;
     int32_t ticks = 0;
@@ -131,6 +145,7 @@ class trainprogram : public QObject {
     int lastStepTimestampChanged = 0;
     double lastCurrentStepDistance = 0.0;
     QTime lastCurrentStepTime = QTime(0, 0, 0);
+    double lastPredictedInclination = -200;
 };
 
 #endif // TRAINPROGRAM_H
@@ -0,0 +1,46 @@
+#include "trainprogramtimeline.h"
+#include "trainprogram.h"
+#include <algorithm>
+
+static uint32_t seconds(const QTime &t) { return t.second() + (t.minute() * 60) + (t.hour() * 3600); }
+
+trainprogramtimeline::trainprogramtimeline(const QList<trainrow> &rows, double ftp) {
+    m_start.reserve(rows.length());
+    m_end.reserve(rows.length());
+    m_ramp.reserve(rows.length());
+    m_zone.reserve(rows.length());
+
+    uint32_t elapsed = 0;
+    for (const trainrow &r : rows) {
+        uint32_t len = seconds(r.duration);
+        m_duration += len;
+        m_start.append(elapsed);
+        // same as trainprogram::calculateTimeForRow: the rows by distance take no time
+        if (r.distance == -1)
+            elapsed += len;
+        m_end.append(elapsed);
+        m_ramp.append({seconds(r.rampDuration), seconds(r.rampElapsed)});
+        m_zone.append(r.power != -1 ? powerZone(r.power, ftp) : 0);
+    }
+}
+
+int trainprogramtimeline::rowAt(uint32_t seconds) const {
+    return std::upper_bound(m_end.constBegin(), m_end.constEnd(), seconds) - m_end.constBegin();
+}
+
+uint8_t trainprogramtimeline::powerZone(double power, double ftp) {
+    double ftpPerc = (power / ftp) * 100.0;
+    if (ftpPerc < 56)
+        return 1;
+    else if (ftpPerc < 76)
+        return 2;
+    else if (ftpPerc < 91)
+        return 3;
+    else if (ftpPerc < 106)
+        return 4;
+    else if (ftpPerc < 121)
+        return 5;
+    else if (ftpPerc < 151)
+        return 6;
+    return 7;
+}
@@ -0,0 +1,62 @@
+#ifndef TRAINPROGRAMTIMELINE_H
+#define TRAINPROGRAMTIMELINE_H
+
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+
+class trainrow;
+
+/**
+ * @brief The times of the rows of a train program, computed once when the rows are loaded: start and end of every
+ * row from the beginning of the program, the ramp times and the power zone of the target. The queries of the
+ * scheduler and of the tiles, every second, are then a binary search or a lookup instead of a sum over all the rows.
+ * The rows by distance have no time (start == end).
+ */
+class trainprogramtimeline {
+  public:
+    trainprogramtimeline() {}
+    /**
+     * @param ftp The FTP for the zones of the power targets. Unit: watts
+     */
+    trainprogramtimeline(const QList<trainrow> &rows, double ftp);
+
+    int count() const { return m_end.length(); }
+    /**
+     * @brief The first row that ends after seconds, count() when seconds is past the end of the program.
+     */
+    int rowAt(uint32_t seconds) const;
+    uint32_t start(int row) const { return (row >= 0 && row < count()) ? m_start.at(row) : total(); }
+    uint32_t end(int row) const { return (row >= 0 && row < count()) ? m_end.at(row) : total(); }
+    /**
+     * @brief The seconds of all the rows by time.
+     */
+    uint32_t total() const { return m_end.isEmpty() ? 0 : m_end.last(); }
+    /**
+     * @brief The seconds of all the rows, the rows by distance included.
+     */
+    uint32_t duration() const { return m_duration; }
+
+    uint32_t rampDuration(int row) const { return (row >= 0 && row < count()) ? m_ramp.at(row).duration : 0; }
+    uint32_t rampElapsed(int row) const { return (row >= 0 && row < count()) ? m_ramp.at(row).elapsed : 0; }
+    /**
+     * @brief The power zone (1-7) of the target of a row, 0 when the row has no power target.
+     */
+    uint8_t zone(int row) const { return (row >= 0 && row < count()) ? m_zone.at(row) : 0; }
+
+    static uint8_t powerZone(double power, double ftp);
+
+  private:
+    struct ramp {
+        uint32_t duration;
+        uint32_t elapsed;
+    };
+
+    QVector<uint32_t> m_start;
+    QVector<uint32_t> m_end;
+    QVector<ramp> m_ramp;
+    QVector<uint8_t> m_zone;
+    uint32_t m_duration = 0;
+};
+
+#endif // TRAINPROGRAMTIMELINE_H
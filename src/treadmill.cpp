@@ -16,6 +16,7 @@ void treadmill::changeInclination(double grade, double inclination) {
     RequestedInclination = grade;
     if (autoResistanceEnable) {
         requestInclination = grade;
+        learnInclinationCommand(grade);
     }
 }
 void treadmill::changeSpeedAndInclination(double speed, double inclination) {
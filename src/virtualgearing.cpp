@@ -0,0 +1,80 @@
+#include "virtualgearing.h"
+#include "qzsettings.h"
+#include <QDebug>
+#include <QSettings>
+#include <QtMath>
+#include <algorithm>
+
+static QVector<int> teeth(const QString &list) {
+    QVector<int> t;
+    for (const QString &s : list.split(QLatin1Char(','))) {
+        int n = s.trimmed().toInt();
+        if (n > 0)
+            t.append(n);
+    }
+    return t;
+}
+
+void virtualgearing::load() {
+    QSettings settings;
+    enabled = settings.value(QZSettings::virtual_gearing, QZSettings::default_virtual_gearing).toBool();
+    double circumference = settings
+                               .value(QZSettings::virtual_gearing_wheel_circumference,
+                                      QZSettings::default_virtual_gearing_wheel_circumference)
+                               .toDouble();
+    QVector<int> chainrings = teeth(
+        settings.value(QZSettings::virtual_gearing_chainrings, QZSettings::default_virtual_gearing_chainrings)
+            .toString());
+    QVector<int> cassette = teeth(
+        settings.value(QZSettings::virtual_gearing_cassette, QZSettings::default_virtual_gearing_cassette).toString());
+
+    struct gear {
+        double ratio;
+        QString name;
+    };
+    QVector<gear> gears;
+    for (int c : qAsConst(chainrings))
+        for (int s : qAsConst(cassette))
+            gears.append({(double)c / (double)s, QString::number(c) + QStringLiteral("x") + QString::number(s)});
+    std::sort(gears.begin(), gears.end(), [](const gear &a, const gear &b) { return a.ratio < b.ratio; });
+
+    meters.clear();
+    names.clear();
+    for (const gear &g : qAsConst(gears)) {
+        // the combinations of the two chainrings that give almost the same ratio are the same gear
+        if (!meters.isEmpty() && g.ratio * circumference < meters.last() * 1.02)
+            continue;
+        meters.append(g.ratio * circumference);
+        names.append(g.name);
+    }
+    neutral = meters.length() / 2;
+    current = neutral;
+    qDebug() << QStringLiteral("virtual gearing") << enabled << names;
+}
+
+int virtualgearing::setGear(int offset) {
+    if (meters.isEmpty())
+        return 0;
+    current = qBound(0, neutral + offset, meters.length() - 1);
+    return current - neutral;
+}
+
+void virtualgearing::setSimulation(double grade, double windSpeed, double crr) {
+    m_grade = grade;
+    this->windSpeed = windSpeed;
+    if (crr > 0)
+        physics.setRollingResistance(crr);
+    simulation = true;
+}
+
+double virtualgearing::power(double cadence) const {
+    if (meters.isEmpty() || cadence <= 0)
+        return 0;
+    return qMax(0.0, physics.powerFromSpeed(speed(cadence), m_grade, windSpeed));
+}
+
+double virtualgearing::grade(double cadence, double speed) const {
+    if (meters.isEmpty() || cadence <= 0 || speed <= 0)
+        return m_grade;
+    return qBound(-20.0, physics.gradeFromPower(power(cadence), speed, windSpeed), 20.0);
+}
@@ -0,0 +1,65 @@
+#ifndef VIRTUALGEARING_H
+#define VIRTUALGEARING_H
+
+#include "routesimulator.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief A virtual drivetrain for the bikes without gears: chainrings and cassette from the settings, the gears
+ * sorted by ratio with the meters of road per crank revolution of every gear precomputed, so a shift only moves an
+ * index. With the simulation parameters of the game (grade, wind, rolling resistance) the gear and the cadence give
+ * the speed on the virtual road and the power needed to keep it.
+ */
+class virtualgearing {
+  public:
+    /**
+     * @brief Read the settings and build the gear table.
+     */
+    void load();
+    bool isEnabled() const { return enabled && !meters.isEmpty(); }
+
+    int gearCount() const { return meters.length(); }
+    /**
+     * @brief Select a gear, as an offset from the neutral gear (the middle of the table).
+     * @return The offset actually selected, limited to the gears available
+     */
+    int setGear(int offset);
+    int gear() const { return current; }
+    const QString &gearName() const { return names.at(current); }
+
+    void setSimulation(double grade, double windSpeed, double crr);
+    void clearSimulation() { simulation = false; }
+    bool hasSimulation() const { return simulation; }
+    double grade() const { return m_grade; }
+
+    /**
+     * @brief The speed on the virtual road in the current gear. Units: km/h
+     */
+    double speed(double cadence) const { return cadence * meters.at(current) * 0.06; }
+    /**
+     * @brief The power to pedal at a cadence in the current gear on the virtual road. Units: watts
+     */
+    double power(double cadence) const;
+    /**
+     * @brief The grade to request to a bike that simulates the road by itself (inclination by hardware) so that at
+     * its own speed it asks the power of the virtual gear. Units: %
+     */
+    double grade(double cadence, double speed) const;
+
+  private:
+    bool enabled = false;
+    // meters of road per crank revolution and names ("50x17") of the gears, from the easiest
+    QVector<double> meters;
+    QStringList names;
+    int current = 0;
+    int neutral = 0;
+
+    routesimulator physics;
+    bool simulation = false;
+    double m_grade = 0;
+    double windSpeed = 0;
+};
+
+#endif // VIRTUALGEARING_H
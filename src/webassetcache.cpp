@@ -0,0 +1,113 @@
+#include "webassetcache.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QVector>
+
+// bigger files are served directly from the disk
+static const qint64 maxAssetSize = 8 * 1024 * 1024;
+static const qint64 maxCacheSize = 32 * 1024 * 1024;
+
+static quint32 crc32(const QByteArray &data) {
+    static const QVector<quint32> table = []() {
+        QVector<quint32> t(256);
+        for (quint32 i = 0; i < 256; i++) {
+            quint32 c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    quint32 crc = 0xFFFFFFFF;
+    for (char ch : data)
+        crc = table[(crc ^ (quint8)ch) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+}
+
+static void appendLE32(QByteArray &out, quint32 v) {
+    for (int i = 0; i < 4; i++)
+        out.append((char)((v >> (8 * i)) & 0xFF));
+}
+
+QByteArray WebAssetCache::gzip(const QByteArray &data) {
+    // qCompress gives the data size (4 bytes) and a zlib stream: the 2 bytes header and the 4 bytes adler32 of
+    // the zlib stream are replaced by the gzip header and trailer
+    QByteArray zlib = qCompress(data, 9);
+    if (zlib.size() <= 4 + 2 + 4)
+        return QByteArray();
+    QByteArray out;
+    out.reserve(zlib.size() + 8);
+    out.append("\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\xff", 10);
+    out.append(zlib.constData() + 6, zlib.size() - 6 - 4);
+    appendLE32(out, crc32(data));
+    appendLE32(out, (quint32)data.size());
+    return out;
+}
+
+void WebAssetCache::clear() {
+    entries.clear();
+    totalSize = 0;
+}
+
+const WebAssetCache::entry *WebAssetCache::load(const QString &path) {
+    QFileInfo info(path);
+    if (!info.isFile() || info.size() > maxAssetSize)
+        return nullptr;
+    auto it = entries.find(path);
+    if (it != entries.end() && it->lastModified == info.lastModified() && it->size == info.size())
+        return &it.value();
+
+    QFile f(path);
+    if (!f.open(QFile::ReadOnly))
+        return nullptr;
+    entry e;
+    e.data = f.readAll();
+    e.size = info.size();
+    e.lastModified = info.lastModified();
+    QString mime = mimeDatabase.mimeTypeForFile(info).name();
+    e.mimeType = mime.toUtf8();
+    if (mime.startsWith(QStringLiteral("text/")) || mime.contains(QStringLiteral("javascript")) ||
+        mime.contains(QStringLiteral("json")) || mime.contains(QStringLiteral("xml"))) {
+        e.gzip = gzip(e.data);
+        if (e.gzip.size() >= e.data.size())
+            e.gzip.clear();
+    }
+    e.etag = '"' + QCryptographicHash::hash(e.data, QCryptographicHash::Md5).toHex().left(16) + '"';
+    static const QRegularExpression versioned(QStringLiteral("[.-]\\d+\\.\\d+(\\.\\d+)?[.-]"));
+    if (versioned.match(info.fileName()).hasMatch())
+        e.cacheControl = QByteArrayLiteral("public, max-age=31536000, immutable");
+    else
+        e.cacheControl = QByteArrayLiteral("no-cache");
+
+    if (it != entries.end())
+        totalSize -= it->data.size() + it->gzip.size();
+    if (totalSize + e.data.size() + e.gzip.size() > maxCacheSize)
+        clear();
+    totalSize += e.data.size() + e.gzip.size();
+    return &entries.insert(path, e).value();
+}
+
+QHttpServerResponse WebAssetCache::response(const QString &path, const QHttpServerRequest &request) {
+    const entry *e = load(path);
+    if (!e)
+        return QHttpServerResponse::fromFile(path);
+
+    if (request.value(QByteArrayLiteral("If-None-Match")).contains(e->etag)) {
+        QHttpServerResponse notModified(QHttpServerResponder::StatusCode::NotModified);
+        notModified.addHeader(QByteArrayLiteral("ETag"), e->etag);
+        notModified.addHeader(QByteArrayLiteral("Cache-Control"), e->cacheControl);
+        return notModified;
+    }
+
+    bool gzipped = !e->gzip.isEmpty() && request.value(QByteArrayLiteral("Accept-Encoding")).contains("gzip");
+    QHttpServerResponse response(e->mimeType, gzipped ? e->gzip : e->data);
+    response.addHeader(QByteArrayLiteral("ETag"), e->etag);
+    response.addHeader(QByteArrayLiteral("Cache-Control"), e->cacheControl);
+    if (!e->gzip.isEmpty())
+        response.addHeader(QByteArrayLiteral("Vary"), QByteArrayLiteral("Accept-Encoding"));
+    if (gzipped)
+        response.addHeader(QByteArrayLiteral("Content-Encoding"), QByteArrayLiteral("gzip"));
+    return response;
+}
@@ -0,0 +1,44 @@
+#ifndef WEBASSETCACHE_H
+#define WEBASSETCACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QHttpServerRequest>
+#include <QHttpServerResponse>
+#include <QMimeDatabase>
+#include <QString>
+
+/**
+ * @brief In memory cache of the files served by the template web server.
+ * The files are read once (and read again only when they change on disk), the text ones are gzipped once,
+ * and the responses carry an ETag so the browsers can revalidate them with If-None-Match.
+ * The versioned files, like jquery-3.6.0.min.js, never change and can be cached by the browsers for a year.
+ */
+class WebAssetCache {
+  public:
+    QHttpServerResponse response(const QString &path, const QHttpServerRequest &request);
+    void clear();
+
+  private:
+    class entry {
+      public:
+        QByteArray data;
+        // empty when the file is not worth compressing
+        QByteArray gzip;
+        QByteArray etag;
+        QByteArray mimeType;
+        QByteArray cacheControl;
+        QDateTime lastModified;
+        qint64 size = 0;
+    };
+
+    const entry *load(const QString &path);
+    static QByteArray gzip(const QByteArray &data);
+
+    QHash<QString, entry> entries;
+    qint64 totalSize = 0;
+    QMimeDatabase mimeDatabase;
+};
+
+#endif // WEBASSETCACHE_H
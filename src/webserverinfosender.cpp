@@ -1,14 +1,28 @@
 #include "webserverinfosender.h"
+#include <QDateTime>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QNetworkReply>
 #include <QtWebSockets/QWebSocket>
+#include "workoutsnapshot.h"
+
+// a client with more than maxClientBacklog bytes still to be written is lagging: the new frames are kept aside
+// until its buffer goes under minClientBacklog
+static const qint64 maxClientBacklog = 256 * 1024;
+static const qint64 minClientBacklog = 64 * 1024;
+static const int maxPendingFrames = 16;
+
+// fetch proxy: requests running at the same time for a host, and size of the response cache
+static const int maxFetchPerHost = 4;
+static const int fetchCacheSize = 16 * 1024 * 1024;
 
 WebServerInfoSender::WebServerInfoSender(const QString &id, QObject *parent) : TemplateInfoSender(id, parent) {
     fetcher = new QNetworkAccessManager(this);
     fetcher->setCookieJar(new QNoCookieJar());
+    fetchCache.setMaxCost(fetchCacheSize);
     connect(fetcher, SIGNAL(finished(QNetworkReply *)), this, SLOT(handleFetcherRequest(QNetworkReply *)));
+    subscriptionClock.start();
     connect(fetcher, SIGNAL(sslErrors(QNetworkReply *, const QList<QSslError> &)), this,
             SLOT(ignoreSSLErrors(QNetworkReply *, const QList<QSslError> &)));
 }
@@ -45,17 +59,155 @@ void WebServerInfoSender::acceptError(QAbstractSocket::SocketError socketError)
 bool WebServerInfoSender::isRunning() const { return innerTcpServer && innerTcpServer->isListening(); }
 bool WebServerInfoSender::send(const QString &data) {
     if (isRunning() && !data.isEmpty()) {
-        bool rv = true, oldrv = false;
-        for (QWebSocket *client : sendToClients) {
-            rv = client->sendTextMessage(data) > 0;
-            if (!oldrv)
-                oldrv = rv;
+        // the same implicitly shared string is used for every client
+        WebSocketFrame frame;
+        frame.text = data;
+        bool rv = true;
+        for (QWebSocket *client : qAsConst(sendToClients)) {
+            if (!sendToClient(client, frame))
+                rv = false;
         }
         return rv;
     } else
         return false;
 }
 
+bool WebServerInfoSender::sendWorkout(const WorkoutSnapshot &snapshot) {
+    if (!isRunning())
+        return false;
+    // the clients with the same subscription share the same serialized frame
+    QHash<QString, WebSocketFrame> frames;
+    qint64 now = subscriptionClock.elapsed();
+    bool rv = true;
+    for (QWebSocket *client : qAsConst(sendToClients)) {
+        QStringList fields;
+        bool cbor = false;
+        auto sub = subscriptions.find(client);
+        if (sub != subscriptions.end()) {
+            // 10% of tolerance, so a rate equal to the update rate is not halved by the timer jitter
+            if (sub->lastSentMs >= 0 && now - sub->lastSentMs + sub->minIntervalMs / 10 < sub->minIntervalMs)
+                continue;
+            sub->lastSentMs = now;
+            fields = sub->fields;
+            cbor = sub->cbor;
+        }
+        QString key = (cbor ? QStringLiteral("cbor:") : QStringLiteral("json:")) + fields.join(',');
+        auto frame = frames.find(key);
+        if (frame == frames.end()) {
+            WebSocketFrame f;
+            f.workout = true;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+            if (cbor)
+                f.binary = snapshot.cborMessage(fields);
+            else
+#endif
+                f.text = QString::fromUtf8(snapshot.message(fields));
+            frame = frames.insert(key, f);
+        }
+        if (!sendToClient(client, *frame))
+            rv = false;
+    }
+    return rv;
+}
+
+bool WebServerInfoSender::sendToClient(QWebSocket *client, const WebSocketFrame &frame) {
+    QList<WebSocketFrame> &pending = pendingFrames[client];
+    if (pending.isEmpty() && client->bytesToWrite() < maxClientBacklog)
+        return (frame.text.isNull() ? client->sendBinaryMessage(frame.binary)
+                                   : client->sendTextMessage(frame.text)) > 0;
+
+    // the client is lagging: a workout frame replaces the stale one, and the oldest frames are dropped
+    // when too many are waiting, so a slow client can't make the memory grow or delay the others
+    if (frame.workout) {
+        for (int i = 0; i < pending.size(); i++) {
+            if (pending.at(i).workout) {
+                pending.removeAt(i);
+                droppedFrames++;
+                break;
+            }
+        }
+    }
+    pending.append(frame);
+    if (pending.size() > maxPendingFrames) {
+        pending.removeFirst();
+        droppedFrames++;
+    }
+    if (droppedFrames && (droppedFrames % 100) == 0)
+        qDebug() << QStringLiteral("WebServerInfoSender dropped") << droppedFrames << QStringLiteral("frames");
+    return true;
+}
+
+void WebServerInfoSender::clientBytesWritten(qint64 bytes) {
+    Q_UNUSED(bytes);
+    QWebSocket *client = qobject_cast<QWebSocket *>(sender());
+    auto it = pendingFrames.find(client);
+    if (it == pendingFrames.end())
+        return;
+    while (!it->isEmpty() && client->bytesToWrite() < minClientBacklog) {
+        WebSocketFrame frame = it->takeFirst();
+        if (frame.text.isNull())
+            client->sendBinaryMessage(frame.binary);
+        else
+            client->sendTextMessage(frame.text);
+    }
+}
+
+bool WebServerInfoSender::processSubscription(QWebSocket *client, const QByteArray &data) {
+    QJsonObject obj = QJsonDocument::fromJson(data).object();
+    QString msg = obj[QStringLiteral("msg")].toString();
+    if (!client || (msg != QStringLiteral("subscribe") && msg != QStringLiteral("unsubscribe")))
+        return false;
+
+    QJsonObject reply;
+    if (msg == QStringLiteral("unsubscribe")) {
+        subscriptions.remove(client);
+        reply[QStringLiteral("msg")] = QStringLiteral("R_unsubscribe");
+    } else {
+        QJsonObject content = obj[QStringLiteral("content")].toObject();
+        WebSocketSubscription sub;
+        for (const auto &field : content[QStringLiteral("fields")].toArray()) {
+            if (!field.toString().isEmpty())
+                sub.fields.append(field.toString());
+        }
+        sub.fields.sort();
+        sub.fields.removeDuplicates();
+        double maxRate = content[QStringLiteral("maxrate")].toDouble(0);
+        if (maxRate > 0)
+            sub.minIntervalMs = qRound64(1000.0 / maxRate);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+        sub.cbor = content[QStringLiteral("encoding")].toString() == QStringLiteral("cbor");
+#else
+        // no QCborMap before Qt 5.12: the reply tells the client that it gets JSON
+        sub.cbor = false;
+#endif
+        subscriptions.insert(client, sub);
+
+        QJsonObject out;
+        out[QStringLiteral("fields")] = QJsonArray::fromStringList(sub.fields);
+        out[QStringLiteral("maxrate")] = maxRate > 0 ? maxRate : 0;
+        out[QStringLiteral("encoding")] = sub.cbor ? QStringLiteral("cbor") : QStringLiteral("json");
+        reply[QStringLiteral("msg")] = QStringLiteral("R_subscribe");
+        reply[QStringLiteral("content")] = out;
+    }
+    WebSocketFrame frame;
+    frame.text = QString::fromUtf8(QJsonDocument(reply).toJson(QJsonDocument::Compact));
+    sendToClient(client, frame);
+    return true;
+}
+
+QByteArray WebServerInfoSender::metrics() const {
+    QByteArray out = metricsProvider ? metricsProvider() : QByteArray();
+    out += QByteArrayLiteral("# HELP qz_websocket_clients Clients connected to the template web server.\n"
+                             "# TYPE qz_websocket_clients gauge\n"
+                             "qz_websocket_clients ") +
+           QByteArray::number(sendToClients.size()) + '\n';
+    out += QByteArrayLiteral("# HELP qz_websocket_dropped_frames_total Frames dropped for lagging clients.\n"
+                             "# TYPE qz_websocket_dropped_frames_total counter\n"
+                             "qz_websocket_dropped_frames_total ") +
+           QByteArray::number(droppedFrames) + '\n';
+    return out;
+}
+
 void WebServerInfoSender::innerStop() {
     if (innerTcpServer) {
         if (isRunning())
@@ -63,7 +215,15 @@ void WebServerInfoSender::innerStop() {
         httpServer->deleteLater();
         clients.clear();
         sendToClients.clear();
+        pendingFrames.clear();
+        subscriptions.clear();
+        qDeleteAll(reply2Req);
         reply2Req.clear();
+        for (const auto &queue : qAsConst(fetchQueuePerHost))
+            qDeleteAll(queue);
+        fetchQueuePerHost.clear();
+        fetchActivePerHost.clear();
+        fetchByKey.clear();
         innerTcpServer = 0;
         httpServer = 0;
     }
@@ -81,6 +241,10 @@ bool WebServerInfoSender::init() {
         if (!httpServer)
             httpServer = new QHttpServer(this);
         relative2Absolute.clear();
+        assetCache.clear();
+        httpServer->route(QStringLiteral("/metrics"), [this]() {
+            return QHttpServerResponse(QByteArrayLiteral("text/plain; version=0.0.4; charset=utf-8"), metrics());
+        });
         for (auto fld : folders) {
             idx = fld.lastIndexOf('/');
             qDebug() << QStringLiteral("Folder") << fld;
@@ -102,7 +266,7 @@ bool WebServerInfoSender::init() {
                                       else {
                                           path += QStringLiteral("/%1").arg(url.path());
                                           qDebug() << "File to look at:" << path;
-                                          return QHttpServerResponse::fromFile(path);
+                                          return assetCache.response(path, request);
                                       }
                                   });
             }
@@ -127,52 +291,114 @@ void WebServerInfoSender::watchdogEvent() {
     }
 }
 
+// parse the Cache-Control (or Expires) of a reply: 0 when it can't be cached
+static qint64 fetchExpiry(QNetworkReply *reply, qint64 now) {
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200 ||
+        reply->rawHeader(QByteArrayLiteral("Vary")).trimmed() == QByteArrayLiteral("*"))
+        return 0;
+    QByteArray cacheControl = reply->rawHeader(QByteArrayLiteral("Cache-Control")).toLower();
+    if (cacheControl.contains("no-store") || cacheControl.contains("no-cache") || cacheControl.contains("private"))
+        return 0;
+    qint64 age = reply->rawHeader(QByteArrayLiteral("Age")).trimmed().toLongLong();
+    for (const QByteArray &directive : cacheControl.split(',')) {
+        QByteArray d = directive.trimmed();
+        if (d.startsWith("max-age=")) {
+            qint64 maxAge = d.mid(8).toLongLong();
+            return maxAge > age ? now + (maxAge - age) * 1000 : 0;
+        }
+    }
+    QDateTime expires =
+        QDateTime::fromString(QString::fromLatin1(reply->rawHeader(QByteArrayLiteral("Expires"))), Qt::RFC2822Date);
+    if (expires.isValid() && expires.toMSecsSinceEpoch() > now)
+        return expires.toMSecsSinceEpoch();
+    return 0;
+}
+
 void WebServerInfoSender::handleFetcherRequest(QNetworkReply *reply) {
-    QPair<QJsonObject, QWebSocket *> reqIdRequester = reply2Req.value(reply);
-    QString req = reqIdRequester.first.operator[](QStringLiteral("req")).toString();
-    QWebSocket *requester = reqIdRequester.second;
-    if (!req.isEmpty() && requester) {
-        QNetworkReply::NetworkError error = reply->error();
-        QString statusText = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
-        int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-        QByteArray body = reply->readAll();
-        QJsonObject out, init;
+    FetchRequest *fetch = reply2Req.take(reply);
+    if (fetch) {
+        FetchResponse response;
+        response.error = reply->error();
+        response.statusText = reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toString();
+        response.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        response.url = reply->url().toString();
+        response.body = reply->readAll();
         QList<QNetworkReply::RawHeaderPair> rHeaders = reply->rawHeaderPairs();
-        QJsonArray headers;
         for (auto p : rHeaders) {
             for (auto line : p.second.split('\n')) {
                 QJsonArray arrv;
                 arrv.append(p.first.constData());
                 arrv.append(line.constData());
-                headers.append(arrv);
+                response.headers.append(arrv);
             }
         }
-        QString respType = reqIdRequester.first.operator[](QStringLiteral("responseType")).toString();
-        init[QStringLiteral("headers")] = headers;
-        init[QStringLiteral("status")] = statusCode;
-        init[QStringLiteral("statusText")] = statusText;
-        init[QStringLiteral("responseURL")] = reply->url().toString();
-        if (respType == QStringLiteral("arraybuffer") || respType == QStringLiteral("blob"))
-            out[QStringLiteral("body")] = QJsonValue(body.toBase64().constData());
-        else
-            out[QStringLiteral("body")] = QJsonValue(body.constData());
-        out[QStringLiteral("init")] = init;
-        out[QStringLiteral("req")] = req;
-        out[QStringLiteral("DBG")] = error;
-        QJsonDocument toSend(out);
-        requester->sendTextMessage(toSend.toJson());
-        reply2Req.remove(reply);
+
+        if (!fetch->cacheKey.isEmpty()) {
+            fetchByKey.remove(fetch->cacheKey);
+            qint64 now = QDateTime::currentMSecsSinceEpoch();
+            if ((response.expires = fetchExpiry(reply, now)) > now)
+                fetchCache.insert(fetch->cacheKey, new FetchResponse(response), qMax(1, response.body.size()));
+        }
+        for (const auto &requester : qAsConst(fetch->requesters))
+            sendFetchResponse(requester.first, requester.second, response);
+
+        // the next request waiting for the same host can start
+        QString host = fetch->request.url().host();
+        fetchActivePerHost[host]--;
+        QList<FetchRequest *> &queue = fetchQueuePerHost[host];
+        if (!queue.isEmpty())
+            startFetch(queue.takeFirst());
+        delete fetch;
     }
     reply->deleteLater();
 }
 
+void WebServerInfoSender::sendFetchResponse(const QJsonObject &req, QWebSocket *requester,
+                                            const FetchResponse &response) {
+    QString reqId = req[QStringLiteral("req")].toString();
+    // the requester may have gone away while the request was in flight
+    if (reqId.isEmpty() || !requester)
+        return;
+    QJsonObject out, init;
+    QString respType = req[QStringLiteral("responseType")].toString();
+    init[QStringLiteral("headers")] = response.headers;
+    init[QStringLiteral("status")] = response.status;
+    init[QStringLiteral("statusText")] = response.statusText;
+    init[QStringLiteral("responseURL")] = response.url;
+    if (respType == QStringLiteral("arraybuffer") || respType == QStringLiteral("blob"))
+        out[QStringLiteral("body")] = QJsonValue(response.body.toBase64().constData());
+    else
+        out[QStringLiteral("body")] = QJsonValue(response.body.constData());
+    out[QStringLiteral("init")] = init;
+    out[QStringLiteral("req")] = reqId;
+    out[QStringLiteral("DBG")] = response.error;
+    QJsonDocument toSend(out);
+    requester->sendTextMessage(toSend.toJson());
+}
+
+void WebServerInfoSender::startFetch(FetchRequest *fetch) {
+    QString host = fetch->request.url().host();
+    int &active = fetchActivePerHost[host];
+    if (active >= maxFetchPerHost) {
+        fetchQueuePerHost[host].append(fetch);
+        return;
+    }
+    active++;
+    QNetworkReply *repl = fetch->post ? fetcher->post(fetch->request, fetch->body) : fetcher->get(fetch->request);
+    reply2Req.insert(repl, fetch);
+}
+
 void WebServerInfoSender::processTextMessage(QString message) {
     /*QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
     if (pClient) {
         pClient->sendTextMessage(message);
     }*/
     //qDebug() << QStringLiteral("Message received:") << message;
-    emit onDataReceived(message.toUtf8());
+    QByteArray data = message.toUtf8();
+    if (message.contains(QLatin1String("subscribe")) &&
+        processSubscription(qobject_cast<QWebSocket *>(sender()), data))
+        return;
+    emit onDataReceived(data);
 }
 
 void WebServerInfoSender::processFetcherRequest(QString data) {
@@ -205,16 +431,33 @@ void WebServerInfoSender::processFetcher(QWebSocket *sender, const QByteArray &d
                     ++i;
                 }
             }
-            QNetworkReply *repl;
+            FetchRequest *fetch = new FetchRequest();
+            fetch->request = request;
+            fetch->requesters.append(qMakePair(jsonObject, QPointer<QWebSocket>(sender)));
             if (method.toLower() == QStringLiteral("post")) {
-                QByteArray body;
+                fetch->post = true;
                 if ((tmpv = jsonObject.value(QStringLiteral("body"))).isString())
-                    body = tmpv.toString().toUtf8();
-                repl = fetcher->post(request, body);
-            } else {
-                repl = fetcher->get(request);
+                    fetch->body = tmpv.toString().toUtf8();
+            } else if (method.toLower() == QStringLiteral("get")) {
+                // the same URL with the same headers gets the same response
+                QJsonDocument headersDoc(jsonObject.value(QStringLiteral("headers")).toObject());
+                fetch->cacheKey = url + '\n' + QString::fromUtf8(headersDoc.toJson(QJsonDocument::Compact));
+                bool noCache = request.rawHeader(QByteArrayLiteral("Cache-Control")).toLower().contains("no-cache");
+                FetchResponse *cached = noCache ? nullptr : fetchCache.object(fetch->cacheKey);
+                if (cached && cached->expires > QDateTime::currentMSecsSinceEpoch()) {
+                    sendFetchResponse(jsonObject, sender, *cached);
+                    delete fetch;
+                    return;
+                }
+                FetchRequest *inFlight = fetchByKey.value(fetch->cacheKey, nullptr);
+                if (inFlight) {
+                    inFlight->requesters.append(qMakePair(jsonObject, QPointer<QWebSocket>(sender)));
+                    delete fetch;
+                    return;
+                }
+                fetchByKey.insert(fetch->cacheKey, fetch);
             }
-            reply2Req[repl] = QPair<QJsonObject, QWebSocket *>(jsonObject, sender);
+            startFetch(fetch);
         }
     }
 }
@@ -229,6 +472,7 @@ void WebServerInfoSender::onNewConnection() {
     } else {
         connect(pSocket, SIGNAL(textMessageReceived(QString)), this, SLOT(processTextMessage(QString)));
         connect(pSocket, SIGNAL(binaryMessageReceived(QByteArray)), this, SLOT(processBinaryMessage(QByteArray)));
+        connect(pSocket, SIGNAL(bytesWritten(qint64)), this, SLOT(clientBytesWritten(qint64)));
         sendToClients << pSocket;
     }
     connect(pSocket, SIGNAL(disconnected()), this, SLOT(socketDisconnected()));
@@ -241,16 +485,11 @@ void WebServerInfoSender::socketDisconnected() {
     qDebug() << QStringLiteral("socketDisconnected:") << pClient;
     if (pClient) {
         clients.removeAll(pClient);
-        if (!sendToClients.removeAll(pClient)) {
-            QMutableHashIterator<QNetworkReply *, QPair<QJsonObject, QWebSocket *>> i(reply2Req);
-            while (i.hasNext()) {
-                i.next();
-                if (i.value().second == pClient) {
-                    i.remove();
-                    break;
-                }
-            }
-        }
+        pendingFrames.remove(pClient);
+        subscriptions.remove(pClient);
+        // the fetch requests of the client are completed anyway (their responses may be cached),
+        // sendFetchResponse skips the clients that have been deleted
+        sendToClients.removeAll(pClient);
         pClient->deleteLater();
     }
 }
@@ -261,5 +500,7 @@ void WebServerInfoSender::processBinaryMessage(QByteArray message) {
         pClient->sendBinaryMessage(message);
     }*/
     //qDebug() << QStringLiteral("Binary Message received:") << message.toHex();
+    if (message.contains("subscribe") && processSubscription(qobject_cast<QWebSocket *>(sender()), message))
+        return;
     emit onDataReceived(message);
 }
@@ -1,10 +1,17 @@
 #ifndef WEBSERVERINFOSENDER_H
 #define WEBSERVERINFOSENDER_H
 #include "templateinfosender.h"
+#include "webassetcache.h"
+#include <QElapsedTimer>
+#include <QCache>
 #include <QHttpServer>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QNetworkAccessManager>
 #include <QNetworkCookie>
 #include <QNetworkCookieJar>
+#include <QPointer>
+#include <functional>
 
 class QNoCookieJar : public QNetworkCookieJar {
     Q_OBJECT
@@ -16,6 +23,57 @@ class QNoCookieJar : public QNetworkCookieJar {
     bool setCookiesFromUrl(const QList<QNetworkCookie> &cookieList, const QUrl &url) { return false; }
 };
 
+/**
+ * @brief Response of the fetch proxy, kept in the cache while the Cache-Control of the server allows it.
+ */
+class FetchResponse {
+  public:
+    int status = 0;
+    int error = 0;
+    QString statusText;
+    QString url;
+    QJsonArray headers;
+    QByteArray body;
+    qint64 expires = 0;
+};
+
+/**
+ * @brief Request of the fetch proxy. The identical GET requests made while one is in flight are not sent again,
+ * their requesters wait for the same reply.
+ */
+class FetchRequest {
+  public:
+    QNetworkRequest request;
+    bool post = false;
+    QByteArray body;
+    // empty when the request can't be shared or cached
+    QString cacheKey;
+    // null when the requester has gone away while the request was in flight
+    QList<QPair<QJsonObject, QPointer<QWebSocket>>> requesters;
+};
+
+class WebSocketFrame {
+  public:
+    QString text;
+    // sent as a binary frame when text is null
+    QByteArray binary;
+    // a newer workout frame replaces this one when the client is lagging
+    bool workout = false;
+};
+
+/**
+ * @brief What a client asked with {msg: "subscribe", content: {fields: [...], maxrate: Hz, encoding: "json"|"cbor"}}.
+ * The clients without a subscription get every workout message with all the values, as JSON.
+ */
+class WebSocketSubscription {
+  public:
+    // sorted, empty for all the values
+    QStringList fields;
+    qint64 minIntervalMs = 0;
+    qint64 lastSentMs = -1;
+    bool cbor = false;
+};
+
 class WebServerInfoSender : public TemplateInfoSender {
     Q_OBJECT
   public:
@@ -23,13 +81,33 @@ class WebServerInfoSender : public TemplateInfoSender {
     virtual ~WebServerInfoSender();
     virtual bool isRunning() const;
     virtual bool send(const QString &data);
+    virtual bool sendWorkout(const WorkoutSnapshot &snapshot);
+    void setMetricsProvider(const std::function<QByteArray()> &provider) { metricsProvider = provider; }
 
   private:
     QHttpServer *httpServer = 0;
     QStringList folders;
+    WebAssetCache assetCache;
     bool listen();
     void processFetcher(QWebSocket *sender, const QByteArray &data);
+    void startFetch(FetchRequest *fetch);
+    void sendFetchResponse(const QJsonObject &req, QWebSocket *requester, const FetchResponse &response);
+    QCache<QString, FetchResponse> fetchCache;
+    // in flight GET requests by cache key
+    QHash<QString, FetchRequest *> fetchByKey;
+    QHash<QString, int> fetchActivePerHost;
+    QHash<QString, QList<FetchRequest *>> fetchQueuePerHost;
+    bool sendToClient(QWebSocket *client, const WebSocketFrame &frame);
+    bool processSubscription(QWebSocket *client, const QByteArray &data);
     QTimer watchdogTimer;
+    // frames waiting for the socket buffer of a lagging client to drain
+    QHash<QWebSocket *, QList<WebSocketFrame>> pendingFrames;
+    QHash<QWebSocket *, WebSocketSubscription> subscriptions;
+    QElapsedTimer subscriptionClock;
+    // the metrics of the app served at /metrics, the web server adds its own ones
+    std::function<QByteArray()> metricsProvider;
+    QByteArray metrics() const;
+    quint64 droppedFrames = 0;
 
   protected:
     virtual void innerStop();
@@ -40,7 +118,7 @@ class WebServerInfoSender : public TemplateInfoSender {
     QNetworkAccessManager *fetcher = 0;
     QList<QWebSocket *> sendToClients;
     QHash<QString, QString> relative2Absolute;
-    QHash<QNetworkReply *, QPair<QJsonObject, QWebSocket *>> reply2Req;
+    QHash<QNetworkReply *, FetchRequest *> reply2Req;
   private slots:
     void acceptError(QAbstractSocket::SocketError socketError);
     void watchdogEvent();
@@ -51,6 +129,7 @@ class WebServerInfoSender : public TemplateInfoSender {
     void processFetcherRequest(QString message);
     void processBinaryMessage(QByteArray message);
     void socketDisconnected();
+    void clientBytesWritten(qint64 bytes);
     void ignoreSSLErrors(QNetworkReply *, const QList<QSslError> &);
 };
 
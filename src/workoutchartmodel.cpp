@@ -0,0 +1,122 @@
+#include "workoutchartmodel.h"
+
+#include <cmath>
+
+workoutchartmodel::workoutchartmodel(QObject *parent) : QAbstractListModel(parent) {}
+
+int workoutchartmodel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid())
+        return 0;
+    return points.count();
+}
+
+QVariant workoutchartmodel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= points.count())
+        return QVariant();
+
+    if (role == TimeRole)
+        return points.at(index.row()).time;
+    if (role >= WattRole && role <= PelotonResistanceRole)
+        return value(index.row(), role);
+    return QVariant();
+}
+
+QHash<int, QByteArray> workoutchartmodel::roleNames() const {
+    return {
+        {TimeRole, QByteArrayLiteral("time")},
+        {WattRole, QByteArrayLiteral("watt")},
+        {HeartRole, QByteArrayLiteral("heart")},
+        {CadenceRole, QByteArrayLiteral("cadence")},
+        {ResistanceRole, QByteArrayLiteral("resistance")},
+        {PelotonResistanceRole, QByteArrayLiteral("peloton_resistance")},
+    };
+}
+
+void workoutchartmodel::append(const SessionLine &s) {
+    beginInsertRows(QModelIndex(), points.count(), points.count());
+    point p;
+    p.time = nextTime;
+    p.values[WattRole - WattRole] = s.watt;
+    p.values[HeartRole - WattRole] = s.heart;
+    p.values[CadenceRole - WattRole] = s.cadence;
+    p.values[ResistanceRole - WattRole] = s.resistance;
+    p.values[PelotonResistanceRole - WattRole] = s.peloton_resistance;
+    points.append(p);
+    nextTime += s.sampleIntervalMs;
+    endInsertRows();
+    emit countChanged(points.count());
+}
+
+void workoutchartmodel::clear() {
+    beginResetModel();
+    points.clear();
+    nextTime = 0;
+    endResetModel();
+    emit countChanged(0);
+}
+
+QVector<QPointF> workoutchartmodel::downsample(int role, int threshold) const {
+    QVector<QPointF> out;
+    const int n = points.count();
+    if (role < WattRole || role > PelotonResistanceRole || n == 0)
+        return out;
+
+    // a chart not laid out yet has no width: it still gets a decimated series, not the whole session
+    threshold = qMax(threshold, minThreshold);
+    if (threshold >= n) {
+        out.reserve(n);
+        for (int i = 0; i < n; i++)
+            out.append(QPointF(points.at(i).time, value(i, role)));
+        return out;
+    }
+
+    out.reserve(threshold);
+    // the first and the last points are always kept, the others are split in threshold - 2 buckets
+    const double every = (double)(n - 2) / (threshold - 2);
+    int a = 0;
+    out.append(QPointF(points.at(0).time, value(0, role)));
+
+    for (int i = 0; i < threshold - 2; i++) {
+        // average of the next bucket, used as the third vertex of the triangle
+        int avgStart = (int)std::floor((i + 1) * every) + 1;
+        int avgEnd = qMin((int)std::floor((i + 2) * every) + 1, n);
+        double avgX = 0;
+        double avgY = 0;
+        for (int j = avgStart; j < avgEnd; j++) {
+            avgX += points.at(j).time;
+            avgY += value(j, role);
+        }
+        int avgLength = avgEnd - avgStart;
+        if (avgLength > 0) {
+            avgX /= avgLength;
+            avgY /= avgLength;
+        }
+
+        // the point of the current bucket with the largest triangle area wins
+        int rangeStart = (int)std::floor(i * every) + 1;
+        int rangeEnd = (int)std::floor((i + 1) * every) + 1;
+        double ax = points.at(a).time;
+        double ay = value(a, role);
+        double maxArea = -1;
+        int next = rangeStart;
+        for (int j = rangeStart; j < rangeEnd; j++) {
+            double area = std::fabs((ax - avgX) * (value(j, role) - ay) - (ax - points.at(j).time) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                next = j;
+            }
+        }
+        out.append(QPointF(points.at(next).time, value(next, role)));
+        a = next;
+    }
+
+    out.append(QPointF(points.at(n - 1).time, value(n - 1, role)));
+    return out;
+}
+
+void workoutchartmodel::fillSeries(QtCharts::QXYSeries *series, const QString &roleName, int threshold) const {
+    if (!series)
+        return;
+    int role = roleNames().key(roleName.toLatin1(), -1);
+    series->replace(downsample(role, threshold));
+}
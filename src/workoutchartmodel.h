@@ -0,0 +1,75 @@
+#ifndef WORKOUTCHARTMODEL_H
+#define WORKOUTCHARTMODEL_H
+
+#include "sessionline.h"
+#include <QAbstractListModel>
+#include <QPointF>
+#include <QVector>
+#include <QtCharts/QXYSeries>
+
+/**
+ * @brief Chart data of the current workout. The points are appended incrementally by the session sampler,
+ * so QML never copies the whole session; the charts read a downsampled (LTTB) version sized to their width.
+ */
+class workoutchartmodel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(qint64 durationMs READ durationMs NOTIFY countChanged)
+
+  public:
+    enum Roles {
+        TimeRole = Qt::UserRole + 1,
+        WattRole,
+        HeartRole,
+        CadenceRole,
+        ResistanceRole,
+        PelotonResistanceRole,
+    };
+
+    explicit workoutchartmodel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return points.count(); }
+    qint64 durationMs() const { return points.isEmpty() ? 0 : points.constLast().time; }
+
+    void append(const SessionLine &s);
+    void clear();
+
+    /**
+     * @brief Largest-Triangle-Three-Buckets downsampling of a role.
+     * @param role One of the value roles.
+     * @param threshold Maximum number of points returned, usually the width of the chart in pixels, at least
+     * minThreshold.
+     * @return The points as (milliseconds from the start, value).
+     */
+    QVector<QPointF> downsample(int role, int threshold) const;
+    static constexpr int minThreshold = 200;
+
+    /**
+     * @brief Replace the content of a chart series with the downsampled values of a role.
+     * @param series The QML LineSeries.
+     * @param roleName The role name, like "watt" or "heart".
+     * @param threshold Maximum number of points, usually the width of the chart in pixels.
+     */
+    Q_INVOKABLE void fillSeries(QtCharts::QXYSeries *series, const QString &roleName, int threshold) const;
+
+  signals:
+    void countChanged(int count);
+
+  private:
+    class point {
+      public:
+        qint64 time;
+        float values[5];
+    };
+
+    double value(int i, int role) const { return points.at(i).values[role - WattRole]; }
+
+    QVector<point> points;
+    qint64 nextTime = 0;
+};
+
+#endif // WORKOUTCHARTMODEL_H
@@ -0,0 +1,241 @@
+#include "workoutlibrary.h"
+#include "gpx.h"
+#include "qzsettings.h"
+#include "routesimulator.h"
+#include "trainprogram.h"
+#include "trainprogramtimeline.h"
+#include "zwiftworkout.h"
+#include <QDebug>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTime>
+#include <QtConcurrent>
+#include <QtMath>
+
+static qint64 modified(const QString &path) { return QFileInfo(path).lastModified().toMSecsSinceEpoch(); }
+
+// the same rows of homeform::gpx_open_clicked, without the coordinates
+static QList<trainrow> gpxRows(const QString &path) {
+    gpx g;
+    QList<trainrow> list;
+    auto points = g.open(path);
+    list.reserve(points.size());
+    gpx_altitude_point_for_treadmill last;
+    bool first = true;
+    for (const auto &p : points) {
+        if (!first) {
+            trainrow r;
+            r.distance = p.distance;
+            r.inclination = p.inclination;
+            r.altitude = last.elevation;
+            list.append(r);
+        }
+        last = p;
+        first = false;
+    }
+    return list;
+}
+
+QString workoutlibrary::entry::summary() const {
+    if (!isValid())
+        return QString();
+    QString s = QTime(0, 0, 0).addSecs(qRound(duration)).toString(QStringLiteral("h:mm:ss"));
+    if (distance > 0)
+        s += QStringLiteral(" - ") + QString::number(distance, 'f', 1) + QStringLiteral(" km");
+    if (tss > 0)
+        s += QStringLiteral(" - TSS ") + QString::number(tss, 'f', 0);
+    return s;
+}
+
+workoutlibrary::workoutlibrary(const QString &indexFile, QObject *parent) : QObject(parent), indexFile(indexFile) {
+    connect(&watcher, &QFutureWatcher<entry>::finished, this, &workoutlibrary::parsed);
+    load();
+}
+
+workoutlibrary::~workoutlibrary() {
+    watcher.cancel();
+    watcher.waitForFinished();
+}
+
+QVector<double> workoutlibrary::model() {
+    QSettings settings;
+    return {settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble(),
+            settings.value(QZSettings::weight, QZSettings::default_weight).toDouble(),
+            settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toDouble(),
+            settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toDouble()};
+}
+
+void workoutlibrary::index(const QStringList &folders) {
+    if (watcher.isRunning())
+        return;
+
+    if (model() != indexModel) {
+        entries.clear();
+        indexModel = model();
+    }
+
+    bool removed = false;
+    for (auto i = entries.begin(); i != entries.end();) {
+        if (!QFileInfo::exists(i.key())) {
+            i = entries.erase(i);
+            removed = true;
+        } else {
+            ++i;
+        }
+    }
+
+    QStringList changed;
+    for (const QString &folder : folders) {
+        QDirIterator it(folder, nameFilters(), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            QString path = it.fileInfo().absoluteFilePath();
+            auto e = entries.constFind(path);
+            if (e == entries.constEnd() || e->mtime != it.fileInfo().lastModified().toMSecsSinceEpoch())
+                changed.append(path);
+        }
+    }
+    qDebug() << QStringLiteral("workoutlibrary") << entries.count() << QStringLiteral("indexed")
+             << changed.count() << QStringLiteral("to parse");
+
+    if (changed.isEmpty()) {
+        if (removed)
+            save();
+        emit indexed(entries.count());
+        return;
+    }
+    watcher.setFuture(QtConcurrent::mapped(changed, &workoutlibrary::parse));
+}
+
+void workoutlibrary::parsed() {
+    if (watcher.isCanceled())
+        return;
+    const QList<entry> results = watcher.future().results();
+    for (const entry &e : results)
+        entries.insert(e.path, e);
+    save();
+    qDebug() << QStringLiteral("workoutlibrary") << results.count() << QStringLiteral("parsed");
+    emit indexed(entries.count());
+}
+
+workoutlibrary::entry workoutlibrary::find(const QString &path) const {
+    auto e = entries.constFind(QFileInfo(path).absoluteFilePath());
+    if (e == entries.constEnd() || e->mtime != modified(path))
+        return entry();
+    return *e;
+}
+
+workoutlibrary::entry workoutlibrary::parse(const QString &path) {
+    entry e;
+    e.path = QFileInfo(path).absoluteFilePath();
+    e.mtime = modified(path);
+
+    QString suffix = QFileInfo(path).suffix().toLower();
+    QList<trainrow> rows;
+    if (suffix == QStringLiteral("zwo"))
+        rows = zwiftworkout::load(path, &e.description, &e.tags);
+    else if (suffix == QStringLiteral("xml"))
+        rows = trainprogram::loadXML(path);
+    // kmlworkout::load() looks up the elevation of every coordinate on the network with a nested event loop, that
+    // has no place in a worker of the pool, and its rows have neither a duration nor a distance: a route is indexed
+    // with an empty profile
+    else if (suffix == QStringLiteral("gpx"))
+        rows = gpxRows(path);
+
+    // routes at an endurance pace, 75% of the FTP, like the preview
+    QSettings settings;
+    double ftp = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+    QVector<routesimulator::row> simulation = routesimulator().simulate(rows, ftp * 0.75);
+    e.duration = routesimulator::duration(simulation);
+
+    // the power of a row: the target, or the simulation for the rows by distance
+    auto watt = [&](int r) { return rows.at(r).distance > 0 ? simulation.at(r).power : rows.at(r).power; };
+    // the meters climbed in a row
+    auto climb = [&](int r) {
+        return rows.at(r).inclination != -200 ? simulation.at(r).distance * 10.0 * rows.at(r).inclination : 0.0;
+    };
+
+    e.zones.fill(0, 7);
+    bool inclination = false;
+    for (int r = 0; r < simulation.length(); r++) {
+        const trainrow &row = rows.at(r);
+        const routesimulator::row &s = simulation.at(r);
+        if (row.distance > 0)
+            e.distance += row.distance;
+        else if (row.speed > 0)
+            e.distance += row.speed * s.seconds / 3600.0;
+        double w = watt(r);
+        if (w > 0 && ftp > 0) {
+            e.tss += s.seconds * (w / ftp) * (w / ftp) / 36.0;
+            e.zones[trainprogramtimeline::powerZone(w, ftp) - 1] += qRound(s.seconds);
+        }
+        if (row.inclination != -200)
+            inclination = true;
+    }
+
+    e.step = qMax(1, qCeil(e.duration / profilePoints));
+    int points = qCeil(e.duration / e.step);
+    e.power.reserve(points);
+    if (inclination)
+        e.elevation.reserve(points);
+    int r = 0;
+    double start = 0;
+    double elevation = 0;
+    for (int k = 0; k < points; k++) {
+        double t = (double)k * e.step;
+        while (r < simulation.length() - 1 && simulation.at(r).elapsed <= t) {
+            elevation += climb(r);
+            start = simulation.at(r).elapsed;
+            r++;
+        }
+        e.power.append(watt(r));
+        if (inclination) {
+            double seconds = simulation.at(r).seconds;
+            e.elevation.append(elevation + (seconds > 0 ? (t - start) / seconds : 0) * climb(r));
+        }
+    }
+    return e;
+}
+
+void workoutlibrary::load() {
+    QFile file(indexFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    QDataStream in(&file);
+    quint32 m;
+    quint16 v;
+    in >> m >> v;
+    if (m != magic || v != version)
+        return;
+    in.setVersion(streamVersion);
+    in >> indexModel >> entries;
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << QStringLiteral("workoutlibrary index corrupted") << indexFile;
+        entries.clear();
+        indexModel.clear();
+    }
+}
+
+void workoutlibrary::save() {
+    QFile file(indexFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << QStringLiteral("workoutlibrary can't write") << indexFile;
+        return;
+    }
+    QDataStream out(&file);
+    out << magic << version;
+    out.setVersion(streamVersion);
+    out << indexModel << entries;
+}
+
+QDataStream &operator<<(QDataStream &out, const workoutlibrary::entry &e) {
+    return out << e.path << e.mtime << e.duration << e.distance << e.tss << e.zones << e.step << e.power
+               << e.elevation << e.description << e.tags;
+}
+
+QDataStream &operator>>(QDataStream &in, workoutlibrary::entry &e) {
+    return in >> e.path >> e.mtime >> e.duration >> e.distance >> e.tss >> e.zones >> e.step >> e.power >>
+           e.elevation >> e.description >> e.tags;
+}
@@ -0,0 +1,91 @@
+#ifndef WORKOUTLIBRARY_H
+#define WORKOUTLIBRARY_H
+
+#include <QDataStream>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Index of the workouts (ZWO, XML, KML) and of the routes (GPX) in the folders of the app: duration, distance,
+ * TSS, time in the power zones and a small power and elevation profile of every file, so the lists and the previews do
+ * not parse the files on the GUI thread. The files are parsed in parallel with QtConcurrent and the results are saved
+ * in a binary index, where an entry is valid while the modification time of its file does not change.
+ */
+class workoutlibrary : public QObject {
+    Q_OBJECT
+
+  public:
+    struct entry {
+        QString path;
+        qint64 mtime = 0;         // ms since epoch
+        double duration = 0;      // seconds, the rows by distance at 75% of the FTP
+        double distance = 0;      // km, 0 when unknown
+        double tss = 0;           // from the power targets
+        QVector<quint32> zones;   // seconds in the power zones 1-7
+        quint32 step = 1;         // seconds between two points of the profiles
+        QVector<float> power;     // watts, -1 where the workout has no power target
+        QVector<float> elevation; // meters from the start, empty without inclination
+        QString description;
+        QString tags;
+
+        bool isValid() const { return !path.isEmpty(); }
+        QString summary() const;
+    };
+
+    explicit workoutlibrary(const QString &indexFile, QObject *parent = nullptr);
+    ~workoutlibrary();
+
+    /**
+     * @brief Parse in background the files of the folders (and of their subfolders) that are new or changed since the
+     * last index.
+     */
+    void index(const QStringList &folders);
+    bool isIndexing() const { return watcher.isRunning(); }
+
+    /**
+     * @brief The entry of a file, invalid when the file is not indexed or it changed after the index.
+     */
+    entry find(const QString &path) const;
+
+    /**
+     * @brief Parse a file. Thread safe: the parsers only use their own QSettings, QXmlStreamReader, QDomDocument and
+     * (gpx) a QObject without parent that lives in the calling thread, and no static or shared state.
+     */
+    static entry parse(const QString &path);
+    static QStringList nameFilters() {
+        return {QStringLiteral("*.zwo"), QStringLiteral("*.xml"), QStringLiteral("*.kml"), QStringLiteral("*.gpx")};
+    }
+
+  signals:
+    void indexed(int count);
+
+  private slots:
+    void parsed();
+
+  private:
+    static constexpr quint32 magic = 0x515A574C; // QZWL
+    static constexpr quint16 version = 2;
+    // a stream version that every supported Qt has
+    static constexpr QDataStream::Version streamVersion = QDataStream::Qt_5_0;
+    // the points of the profiles, enough for the preview chart
+    static constexpr int profilePoints = 600;
+
+    // the settings the entries depend on (FTP, weights, rolling resistance): a change invalidates the index
+    static QVector<double> model();
+    void load();
+    void save();
+
+    QString indexFile;
+    QVector<double> indexModel;
+    QHash<QString, entry> entries;
+    QFutureWatcher<entry> watcher;
+};
+
+QDataStream &operator<<(QDataStream &out, const workoutlibrary::entry &e);
+QDataStream &operator>>(QDataStream &in, workoutlibrary::entry &e);
+
+#endif // WORKOUTLIBRARY_H
@@ -0,0 +1,163 @@
+#include "workoutsnapshot.h"
+#include "bike.h"
+#include "elliptical.h"
+#include "rower.h"
+#include "treadmill.h"
+#include <QJsonDocument>
+#include <QTime>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+#include <QCborValue>
+#endif
+
+static void splitTime(const QTime &t, int out[3]) {
+    out[0] = t.second();
+    out[1] = t.minute();
+    out[2] = t.hour();
+}
+
+void WorkoutSnapshot::capture(bluetoothdevice *device, const QString &nickName, const QString &workoutName,
+                              const QString &workoutStartDate, const QString &instructorName) {
+    jsonCache.clear();
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+    cborCache.clear();
+#endif
+    deviceValues.clear();
+    hasDevice = device != nullptr;
+    if (!device) {
+        deviceId.clear();
+        return;
+    }
+
+    metric dep;
+    bluetoothdevice::BLUETOOTH_TYPE tp = device->deviceType();
+#ifdef Q_OS_IOS
+    deviceId = device->bluetoothDevice.deviceUuid().toString();
+#else
+    deviceId = device->bluetoothDevice.address().toString();
+#endif
+    deviceName = device->bluetoothDevice.name();
+    if (deviceName.isEmpty())
+        deviceName = QStringLiteral("N/A");
+    deviceRSSI = device->bluetoothDevice.rssi();
+    deviceType = (int)tp;
+    deviceConnected = device->connected();
+    devicePaused = device->isPaused();
+    splitTime(device->elapsedTime(), elapsed);
+    splitTime(device->currentPace(), pace);
+    splitTime(device->movingTime(), moving);
+    speed = (dep = device->currentSpeed()).value();
+    speedAvg = dep.average();
+    calories = device->calories().value();
+    distance = device->odometer();
+    heart = (dep = device->currentHeart()).value();
+    heartAvg = dep.average();
+    heartMax = dep.max();
+    jouls = device->jouls().value();
+    elevation = device->elevationGain().value();
+    difficult = device->difficult();
+    watts = (dep = device->wattsMetric()).value();
+    wattsAvg = dep.average();
+    wattsMax = dep.max();
+    kgwatts = (dep = device->wattKg()).value();
+    kgwattsAvg = dep.average();
+    kgwattsMax = dep.max();
+    this->workoutName = workoutName;
+    this->workoutStartDate = workoutStartDate;
+    this->instructorName = instructorName;
+    QGeoCoordinate coordinate = device->currentCordinate();
+    latitude = coordinate.latitude();
+    longitude = coordinate.longitude();
+    altitude = coordinate.altitude();
+    this->nickName = nickName.isEmpty() ? QStringLiteral("N/A") : nickName;
+
+    if (tp == bluetoothdevice::BIKE) {
+        bike *b = (bike *)device;
+        deviceValues.append({QStringLiteral("peloton_resistance"), b->pelotonResistance().value()});
+        deviceValues.append(
+            {QStringLiteral("peloton_req_resistance"), (dep = b->lastRequestedPelotonResistance()).value()});
+        deviceValues.append({QStringLiteral("peloton_resistance_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("cadence"), (dep = b->currentCadence()).value()});
+        deviceValues.append({QStringLiteral("cadence_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("resistance"), (dep = b->currentResistance()).value()});
+        deviceValues.append({QStringLiteral("resistance_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("cranks"), b->currentCrankRevolutions()});
+        deviceValues.append({QStringLiteral("cranktime"), (double)b->lastCrankEventTime()});
+        deviceValues.append({QStringLiteral("req_power"), b->lastRequestedPower().value()});
+        deviceValues.append({QStringLiteral("req_cadence"), b->lastRequestedCadence().value()});
+        deviceValues.append({QStringLiteral("req_resistance"), b->lastRequestedResistance().value()});
+    } else if (tp == bluetoothdevice::ROWING) {
+        rower *r = (rower *)device;
+        deviceValues.append({QStringLiteral("peloton_resistance"), (dep = r->pelotonResistance()).value()});
+        deviceValues.append({QStringLiteral("peloton_resistance_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("cadence"), (dep = r->currentCadence()).value()});
+        deviceValues.append({QStringLiteral("cadence_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("resistance"), (dep = r->currentResistance()).value()});
+        deviceValues.append({QStringLiteral("resistance_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("cranks"), r->currentCrankRevolutions()});
+        deviceValues.append({QStringLiteral("cranktime"), (double)r->lastCrankEventTime()});
+        deviceValues.append({QStringLiteral("strokescount"), r->currentStrokesCount().value()});
+        deviceValues.append({QStringLiteral("strokeslength"), r->currentStrokesLength().value()});
+    } else if (tp == bluetoothdevice::TREADMILL) {
+        treadmill *t = (treadmill *)device;
+        deviceValues.append({QStringLiteral("inclination"), (dep = t->currentInclination()).value()});
+        deviceValues.append({QStringLiteral("inclination_avg"), dep.average()});
+        deviceValues.append({QStringLiteral("stridelength"), t->currentStrideLength().value()});
+        deviceValues.append({QStringLiteral("groundcontact"), t->currentGroundContact().value()});
+        deviceValues.append({QStringLiteral("verticaloscillation"), t->currentVerticalOscillation().value()});
+    } else if (tp == bluetoothdevice::ELLIPTICAL) {
+        deviceValues.append(
+            {QStringLiteral("inclination"), (dep = ((elliptical *)device)->currentInclination()).value()});
+        deviceValues.append({QStringLiteral("inclination_avg"), dep.average()});
+    }
+}
+
+QJsonObject WorkoutSnapshot::toJsonObject(const QStringList &fields) const {
+    QJsonObject obj;
+    forEachConstant([&obj](const QString &key, int value) { obj.insert(key, value); });
+    if (hasDevice)
+        forEachField(fields, [&obj](const QString &key, const auto &value) { obj.insert(key, value); });
+    return obj;
+}
+
+const QByteArray &WorkoutSnapshot::json() const {
+    if (jsonCache.isEmpty())
+        jsonCache = QJsonDocument(toJsonObject()).toJson(QJsonDocument::Compact);
+    return jsonCache;
+}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+const QByteArray &WorkoutSnapshot::cbor() const {
+    if (cborCache.isEmpty())
+        cborCache = toCborMap().toCborValue().toCbor();
+    return cborCache;
+}
+
+QCborMap WorkoutSnapshot::toCborMap(const QStringList &fields) const {
+    QCborMap map;
+    forEachConstant([&map](const QString &key, int value) { map.insert(key, value); });
+    if (hasDevice)
+        forEachField(fields, [&map](const QString &key, const auto &value) { map.insert(key, QCborValue(value)); });
+    return map;
+}
+
+QByteArray WorkoutSnapshot::cborMessage(const QStringList &fields) const {
+    QCborMap msg;
+    msg.insert(QStringLiteral("msg"), QStringLiteral("workout"));
+    msg.insert(QStringLiteral("content"), toCborMap(fields));
+    return msg.toCborValue().toCbor();
+}
+#endif
+
+QByteArray WorkoutSnapshot::message(const QStringList &fields) const {
+    QByteArray content =
+        fields.isEmpty() ? json() : QJsonDocument(toJsonObject(fields)).toJson(QJsonDocument::Compact);
+    return QByteArrayLiteral("{\"msg\":\"workout\",\"content\":") + content + '}';
+}
+
+void WorkoutSnapshot::fillJSValue(QJSValue &obj) const {
+    if (!hasDevice) {
+        obj.setProperty(QStringLiteral("deviceId"), QJSValue());
+        return;
+    }
+    forEachField([&obj](const QString &key, const auto &value) { obj.setProperty(key, value); });
+}
@@ -0,0 +1,162 @@
+#ifndef WORKOUTSNAPSHOT_H
+#define WORKOUTSNAPSHOT_H
+
+#include "bluetoothdevice.h"
+#include <QByteArray>
+#include <QJSEngine>
+#include <QJsonObject>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+#include <QCborMap>
+#endif
+
+/**
+ * @brief The values of the workout published to the templates, captured once per update tick.
+ * The snapshot is serialized only once (compact JSON, or CBOR) and the same bytes are shared by every sender
+ * and by the session history; the "workout" JS object is filled only when a template script needs it.
+ */
+class WorkoutSnapshot {
+  public:
+    /**
+     * @brief Read the current values of the device. A null device gives an empty snapshot.
+     */
+    void capture(bluetoothdevice *device, const QString &nickName, const QString &workoutName,
+                 const QString &workoutStartDate, const QString &instructorName);
+
+    bool isEmpty() const { return !hasDevice; }
+    bool paused() const { return devicePaused; }
+
+    /**
+     * @brief The snapshot as a JSON object.
+     * @param fields The names of the values to include, all of them when empty.
+     */
+    QJsonObject toJsonObject(const QStringList &fields = QStringList()) const;
+    /**
+     * @brief Compact JSON of the snapshot, serialized on the first call after capture().
+     */
+    const QByteArray &json() const;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+    /**
+     * @brief CBOR map of the snapshot, serialized on the first call after capture().
+     */
+    const QByteArray &cbor() const;
+    QCborMap toCborMap(const QStringList &fields = QStringList()) const;
+    /**
+     * @brief The workout message of the templates, {msg: "workout", content: snapshot}, as CBOR.
+     */
+    QByteArray cborMessage(const QStringList &fields = QStringList()) const;
+#endif
+    /**
+     * @brief The workout message of the templates, {msg: "workout", content: snapshot}, as compact JSON.
+     */
+    QByteArray message(const QStringList &fields = QStringList()) const;
+    /**
+     * @brief Copy the snapshot in the properties of a JS object (the "workout" object of the templates).
+     */
+    void fillJSValue(QJSValue &obj) const;
+
+  private:
+    template <typename F> void forEachField(const QStringList &fields, F f) const {
+        forEachField([&fields, &f](const QString &key, const auto &value) {
+            if (fields.isEmpty() || fields.contains(key))
+                f(key, value);
+        });
+    }
+    // the device type constants the web templates compare deviceType with, sent with or without a device
+    template <typename F> static void forEachConstant(F f) {
+        f(QStringLiteral("BIKE_TYPE"), (int)bluetoothdevice::BIKE);
+        f(QStringLiteral("ELLIPTICAL_TYPE"), (int)bluetoothdevice::ELLIPTICAL);
+        f(QStringLiteral("ROWING_TYPE"), (int)bluetoothdevice::ROWING);
+        f(QStringLiteral("TREADMILL_TYPE"), (int)bluetoothdevice::TREADMILL);
+        f(QStringLiteral("UNKNOWN_TYPE"), (int)bluetoothdevice::UNKNOWN);
+    }
+    template <typename F> void forEachField(F f) const {
+        f(QStringLiteral("deviceId"), deviceId);
+        f(QStringLiteral("deviceName"), deviceName);
+        f(QStringLiteral("deviceRSSI"), deviceRSSI);
+        f(QStringLiteral("deviceType"), deviceType);
+        f(QStringLiteral("deviceConnected"), deviceConnected);
+        f(QStringLiteral("devicePaused"), devicePaused);
+        f(QStringLiteral("elapsed_s"), elapsed[0]);
+        f(QStringLiteral("elapsed_m"), elapsed[1]);
+        f(QStringLiteral("elapsed_h"), elapsed[2]);
+        f(QStringLiteral("pace_s"), pace[0]);
+        f(QStringLiteral("pace_m"), pace[1]);
+        f(QStringLiteral("pace_h"), pace[2]);
+        f(QStringLiteral("moving_s"), moving[0]);
+        f(QStringLiteral("moving_m"), moving[1]);
+        f(QStringLiteral("moving_h"), moving[2]);
+        f(QStringLiteral("speed"), speed);
+        f(QStringLiteral("speed_avg"), speedAvg);
+        f(QStringLiteral("calories"), calories);
+        f(QStringLiteral("distance"), distance);
+        f(QStringLiteral("heart"), heart);
+        f(QStringLiteral("heart_avg"), heartAvg);
+        f(QStringLiteral("heart_max"), heartMax);
+        f(QStringLiteral("jouls"), jouls);
+        f(QStringLiteral("elevation"), elevation);
+        f(QStringLiteral("difficult"), difficult);
+        f(QStringLiteral("watts"), watts);
+        f(QStringLiteral("watts_avg"), wattsAvg);
+        f(QStringLiteral("watts_max"), wattsMax);
+        f(QStringLiteral("kgwatts"), kgwatts);
+        f(QStringLiteral("kgwatts_avg"), kgwattsAvg);
+        f(QStringLiteral("kgwatts_max"), kgwattsMax);
+        f(QStringLiteral("workoutName"), workoutName);
+        f(QStringLiteral("workoutStartDate"), workoutStartDate);
+        f(QStringLiteral("instructorName"), instructorName);
+        f(QStringLiteral("latitude"), latitude);
+        f(QStringLiteral("longitude"), longitude);
+        f(QStringLiteral("altitude"), altitude);
+        f(QStringLiteral("nickName"), nickName);
+        for (const auto &e : deviceValues)
+            f(e.first, e.second);
+    }
+
+    bool hasDevice = false;
+    QString deviceId;
+    QString deviceName;
+    int deviceRSSI = 0;
+    int deviceType = bluetoothdevice::UNKNOWN;
+    bool deviceConnected = false;
+    bool devicePaused = false;
+    // seconds, minutes, hours
+    int elapsed[3] = {0, 0, 0};
+    int pace[3] = {0, 0, 0};
+    int moving[3] = {0, 0, 0};
+    double speed = 0;
+    double speedAvg = 0;
+    double calories = 0;
+    double distance = 0;
+    double heart = 0;
+    double heartAvg = 0;
+    double heartMax = 0;
+    double jouls = 0;
+    double elevation = 0;
+    double difficult = 0;
+    double watts = 0;
+    double wattsAvg = 0;
+    double wattsMax = 0;
+    double kgwatts = 0;
+    double kgwattsAvg = 0;
+    double kgwattsMax = 0;
+    QString workoutName;
+    QString workoutStartDate;
+    QString instructorName;
+    double latitude = 0;
+    double longitude = 0;
+    double altitude = 0;
+    QString nickName;
+    // values available only for some device types (cadence, resistance, inclination...)
+    QVector<QPair<QString, double>> deviceValues;
+
+    mutable QByteArray jsonCache;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+    mutable QByteArray cborCache;
+#endif
+};
+
+#endif // WORKOUTSNAPSHOT_H